@@ -0,0 +1,114 @@
+//  CBHDeviceShards.hpp
+//  CBHFileSystemEventKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#ifndef CBHDeviceShards_hpp
+#define CBHDeviceShards_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <sys/stat.h>
+
+
+/** Groups watched paths by the device they live on so each device can be watched, and its events handled,
+ * independently of the others.
+ */
+namespace cbh
+{
+
+/// A group of paths which all live on the same device.
+struct DeviceShard
+{
+	/// The device the paths live on, or `0` if it could not be determined.
+	std::uint64_t device;
+
+	/// The positions of the paths in the list that was sharded.
+	std::vector<std::size_t> indices;
+};
+
+/** Finds the device holding `path`. Paths which do not exist yet are attributed to the device of their nearest existing
+ * ancestor, since that is where they will be created.
+ *
+ * @param path          The path to look up.
+ *
+ * @return              The device, or `0` if it could not be determined.
+ */
+inline std::uint64_t deviceOfPath(std::string path)
+{
+	struct stat info;
+
+	while ( ::stat(path.c_str(), &info) != 0 )
+	{
+		const std::size_t slash = path.find_last_of('/');
+
+		if ( slash == std::string::npos )
+		{
+			if ( path == "." ) { return 0; }
+			path = ".";
+		}
+		else if ( slash == 0 )
+		{
+			if ( path == "/" ) { return 0; }
+			path = "/";
+		}
+		else
+		{
+			path.erase(slash);
+		}
+	}
+
+	return static_cast<std::uint64_t>(info.st_dev);
+}
+
+/** Groups `paths` by device. Shards, and the paths within them, keep the order in which they first appear.
+ *
+ * @param paths         The paths to group.
+ *
+ * @return              One shard per device.
+ */
+inline std::vector<DeviceShard> shardByDevice(const std::vector<std::string> &paths)
+{
+	std::vector<DeviceShard> shards;
+
+	for (std::size_t i = 0; i < paths.size(); ++i)
+	{
+		const std::uint64_t device = deviceOfPath(paths[i]);
+
+		DeviceShard *shard = nullptr;
+		for (DeviceShard &candidate : shards)
+		{
+			if ( candidate.device == device ) { shard = &candidate; break; }
+		}
+
+		if ( !shard )
+		{
+			shards.push_back({device, {}});
+			shard = &shards.back();
+		}
+
+		shard->indices.push_back(i);
+	}
+
+	return shards;
+}
+
+}
+
+#endif /* CBHDeviceShards_hpp */
@@ -0,0 +1,282 @@
+//  CBHEventPipeline.hpp
+//  CBHFileSystemEventKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#ifndef CBHEventPipeline_hpp
+#define CBHEventPipeline_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <tuple>
+#include <utility>
+
+
+/** A header-only core for processing raw batches of file system events.
+ *
+ * An `EventPipeline` is composed at compile time from four policies:
+ *
+ *  - A **Source** describes the layout of a raw batch. It provides a `Batch` type along with static `size(batch)` and
+ *    `at(batch, index)` functions which return the number of events and each `Event`.
+ *  - A **Filter** is a callable taking an `Event` and returning `true` if it should continue down the pipeline.
+ *  - A **Coalescer** provides `push(event, emit)` and `flush(emit)` and decides which events reach the sink and when.
+ *  - A **Sink** is a callable taking an `Event`.
+ *
+ * Every stage is called directly so the whole pipeline inlines into a single loop over the batch with no virtual calls
+ * and no allocation per event.
+ */
+namespace cbh
+{
+
+// MARK: - Event
+
+/// A single event. `path` is owned by the batch and is only valid while the batch is being processed.
+struct Event
+{
+	const char *path;
+	std::uint64_t flags;
+	std::uint64_t eventId;
+};
+
+
+// MARK: - Sources
+
+/** Source for batches delivered as parallel arrays of paths, flags and ids, as FSEvents does.
+ *
+ * @tparam Flag         The type of each flag.
+ * @tparam Id           The type of each id.
+ */
+template <typename Flag = std::uint32_t, typename Id = std::uint64_t>
+struct ParallelArraySource
+{
+	struct Batch
+	{
+		std::size_t count;
+		const char * const *paths;
+		const Flag *flags;
+		const Id *ids;
+	};
+
+	static std::size_t size(const Batch &batch) noexcept
+	{
+		return batch.count;
+	}
+
+	static Event at(const Batch &batch, std::size_t index) noexcept
+	{
+		return {batch.paths[index], static_cast<std::uint64_t>(batch.flags[index]), static_cast<std::uint64_t>(batch.ids[index])};
+	}
+};
+
+/// Source for batches which are already a contiguous array of events.
+struct EventArraySource
+{
+	struct Batch
+	{
+		const Event *events;
+		std::size_t count;
+	};
+
+	static std::size_t size(const Batch &batch) noexcept
+	{
+		return batch.count;
+	}
+
+	static const Event &at(const Batch &batch, std::size_t index) noexcept
+	{
+		return batch.events[index];
+	}
+};
+
+
+// MARK: - Filters
+
+/// Filter which accepts every event.
+struct AcceptAll
+{
+	constexpr bool operator()(const Event &) const noexcept
+	{
+		return true;
+	}
+};
+
+/// Filter which accepts events with any of the flags in `mask`.
+struct AnyFlags
+{
+	std::uint64_t mask;
+
+	constexpr bool operator()(const Event &event) const noexcept
+	{
+		return ( (event.flags & mask) != 0 );
+	}
+};
+
+/// Filter which rejects events with any of the flags in `mask`.
+struct NoFlags
+{
+	std::uint64_t mask;
+
+	constexpr bool operator()(const Event &event) const noexcept
+	{
+		return ( (event.flags & mask) == 0 );
+	}
+};
+
+/** Filter which accepts an event only if every one of `Filters` does. Evaluation stops at the first rejection.
+ *
+ * @tparam Filters      The filters to compose.
+ */
+template <typename... Filters>
+struct AllOf
+{
+	std::tuple<Filters...> filters;
+
+	constexpr bool operator()(const Event &event) const
+	{
+		return std::apply([&event](const Filters &... filter) { return ( filter(event) && ... ); }, filters);
+	}
+};
+
+/** Filter which accepts an event if any one of `Filters` does. Evaluation stops at the first acceptance.
+ *
+ * @tparam Filters      The filters to compose.
+ */
+template <typename... Filters>
+struct AnyOf
+{
+	std::tuple<Filters...> filters;
+
+	constexpr bool operator()(const Event &event) const
+	{
+		return std::apply([&event](const Filters &... filter) { return ( filter(event) || ... ); }, filters);
+	}
+};
+
+
+// MARK: - Coalescers
+
+/// Coalescer which passes every event straight through.
+struct NoCoalescing
+{
+	template <typename Emit>
+	void push(const Event &event, Emit &&emit)
+	{
+		emit(event);
+	}
+
+	template <typename Emit>
+	void flush(Emit &&) {}
+};
+
+/// Coalescer which merges runs of consecutive events for the same path into one, combining their flags and keeping the
+/// latest id. Runs never span batches.
+struct AdjacentPathCoalescing
+{
+	template <typename Emit>
+	void push(const Event &event, Emit &&emit)
+	{
+		if ( _hasPending && std::strcmp(_pending.path, event.path) == 0 )
+		{
+			_pending.flags |= event.flags;
+			_pending.eventId = event.eventId;
+			return;
+		}
+
+		if ( _hasPending ) { emit(_pending); }
+
+		_pending = event;
+		_hasPending = true;
+	}
+
+	template <typename Emit>
+	void flush(Emit &&emit)
+	{
+		if ( !_hasPending ) { return; }
+
+		_hasPending = false;
+		emit(_pending);
+	}
+
+private:
+
+	Event _pending = {nullptr, 0, 0};
+	bool _hasPending = false;
+};
+
+
+// MARK: - Pipeline
+
+/** Processes raw batches from `Source` through `Filter` and `Coalescer` into `Sink`.
+ *
+ * @tparam Source       Describes the layout of a raw batch.
+ * @tparam Filter       Decides which events continue down the pipeline.
+ * @tparam Coalescer    Decides which events reach the sink and when.
+ * @tparam Sink         Receives the resulting events.
+ */
+template <typename Source, typename Filter, typename Coalescer, typename Sink>
+class EventPipeline
+{
+public:
+
+	using Batch = typename Source::Batch;
+
+	/** Creates a pipeline.
+	 *
+	 * @param sink          The sink to deliver events to.
+	 * @param filter        The filter to apply to each event.
+	 * @param coalescer     The coalescer to pass filtered events through.
+	 */
+	explicit EventPipeline(Sink sink, Filter filter = Filter(), Coalescer coalescer = Coalescer()) :
+		_filter(std::move(filter)),
+		_coalescer(std::move(coalescer)),
+		_sink(std::move(sink))
+	{}
+
+	/** Processes every event in `batch`. Anything held by the coalescer is flushed before returning.
+	 *
+	 * @param batch         The batch to process.
+	 */
+	void operator()(const Batch &batch)
+	{
+		auto emit = [this](const Event &event) { _sink(event); };
+
+		const std::size_t count = Source::size(batch);
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			const Event &event = Source::at(batch, i);
+			if ( !_filter(event) ) { continue; }
+
+			_coalescer.push(event, emit);
+		}
+
+		_coalescer.flush(emit);
+	}
+
+	Filter &filter() noexcept { return _filter; }
+	Coalescer &coalescer() noexcept { return _coalescer; }
+	Sink &sink() noexcept { return _sink; }
+
+private:
+
+	Filter _filter;
+	Coalescer _coalescer;
+	Sink _sink;
+};
+
+}
+
+#endif /* CBHEventPipeline_hpp */
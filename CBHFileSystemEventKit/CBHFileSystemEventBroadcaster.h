@@ -0,0 +1,115 @@
+//  CBHFileSystemEventBroadcaster.h
+//  CBHFileSystemEventKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+@import Foundation;
+
+#import <CBHFileSystemEventKit/CBHFileSystemWatcher.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/** A file system watcher which publishes its events to other processes rather than handling them itself.
+ *
+ * Events are written as compact records into a ring in shared memory which any number of `CBHFileSystemEventReader`s,
+ * in any process of the same user, can attach to by name. The broadcaster never waits on its readers; a reader which
+ * falls a full ring behind receives a `CBHFileSystemEventType_mustScanSubDirs | CBHFileSystemEventType_userDropped`
+ * event for each watched path in place of the events it missed.
+ *
+ * A name belongs to one live broadcaster at a time. Creating a second broadcaster with the same name fails until the
+ * first is deallocated or its process exits.
+ *
+ * @author              Christian Huxtable <chris@huxtable.ca>
+ * @version             1.0
+ */
+@interface CBHFileSystemEventBroadcaster : CBHFileSystemWatcher
+
+#pragma mark - Factories
+
+/**
+ * @name Factories
+ */
+
+/** Creates and returns a file system event broadcaster.
+ *
+ * @param name          The name readers use to attach. Must be at most 30 characters.
+ * @param paths         The paths to watch for events.
+ * @param type          The type of events to watch for.
+ *
+ * @return              The broadcaster, or `nil` if it could not be created.
+ */
++ (nullable instancetype)broadcasterWithName:(NSString *)name ofPaths:(NSArray<NSString *> *)paths withType:(CBHFileSystemWatcherType)type;
+
+/** Creates and returns a file system event broadcaster.
+ *
+ * @param name          The name readers use to attach. Must be at most 30 characters.
+ * @param paths         The paths to watch for events.
+ * @param type          The type of events to watch for.
+ * @param latency       The number of seconds the watcher should wait before publishing events.
+ *
+ * @return              The broadcaster, or `nil` if it could not be created.
+ */
++ (nullable instancetype)broadcasterWithName:(NSString *)name ofPaths:(NSArray<NSString *> *)paths withType:(CBHFileSystemWatcherType)type andLatency:(NSTimeInterval)latency;
+
+
+#pragma mark - Initializers
+
+/**
+ * @name Initializers
+ */
+
+/** Initializes a newly allocated file system event broadcaster.
+ *
+ * @param name          The name readers use to attach. Must be at most 30 characters.
+ * @param paths         The paths to watch for events.
+ * @param type          The type of events to watch for.
+ * @param latency       The number of seconds the watcher should wait before publishing events.
+ * @param capacity      The number of bytes of shared memory to use for events. Rounded up to a power of two, at most 2 GiB.
+ *
+ * @return              The initialized broadcaster, or `nil` if the capacity is too large or the shared memory could not be created.
+ */
+- (nullable instancetype)initWithName:(NSString *)name paths:(NSArray<NSString *> *)paths type:(CBHFileSystemWatcherType)type latency:(NSTimeInterval)latency andCapacity:(size_t)capacity NS_DESIGNATED_INITIALIZER;
+
+
+#pragma mark - Properties
+
+/**
+ * @name Properties
+ */
+
+/// The name readers use to attach.
+@property (nonatomic, readonly) NSString *name;
+
+/// The number of bytes of shared memory used for events.
+@property (nonatomic, readonly) size_t capacity;
+
+/// The number of readers currently attached.
+@property (nonatomic, readonly) NSUInteger readerCount;
+
+
+#pragma mark - Unavailable
+
+/**
+* @name Unavailable
+*/
+
+- (nullable instancetype)initWithObserver:(id)observer andSelector:(SEL)selector ofPaths:(NSArray<NSString *> *)paths withType:(CBHFileSystemWatcherType)type latency:(NSTimeInterval)latency andObject:(nullable id)object NS_UNAVAILABLE;
+- (nullable instancetype)initWithPaths:(NSArray<NSString *> *)paths type:(CBHFileSystemWatcherType)type latency:(NSTimeInterval)latency andBlock:(CBHFileSystemWatcherBlock)block NS_UNAVAILABLE;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,98 @@
+//  CBHFileSystemEventBroadcaster.m
+//  CBHFileSystemEventKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#import "CBHFileSystemEventBroadcaster.h"
+#import "_CBHFileSystemWatcher.h"
+
+#import "_CBHFileSystemEventRing.h"
+
+
+#define CBHFileSystemEventBroadcaster_defaultLatency 3.0
+#define CBHFileSystemEventBroadcaster_defaultCapacity (1 << 20)
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface CBHFileSystemEventBroadcaster ()
+{
+	_CBHFileSystemEventRing *_ring;
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
+
+
+@implementation CBHFileSystemEventBroadcaster
+
+#pragma mark - Factories
+
++ (instancetype)broadcasterWithName:(NSString *)name ofPaths:(NSArray<NSString *> *)paths withType:(CBHFileSystemWatcherType)type
+{
+	return [self broadcasterWithName:name ofPaths:paths withType:type andLatency:CBHFileSystemEventBroadcaster_defaultLatency];
+}
+
++ (instancetype)broadcasterWithName:(NSString *)name ofPaths:(NSArray<NSString *> *)paths withType:(CBHFileSystemWatcherType)type andLatency:(NSTimeInterval)latency
+{
+	return [[[self alloc] initWithName:name paths:paths type:type latency:latency andCapacity:CBHFileSystemEventBroadcaster_defaultCapacity] startWatching];
+}
+
+
+#pragma mark - Initializers
+
+- (instancetype)initWithName:(NSString *)name paths:(NSArray<NSString *> *)paths type:(CBHFileSystemWatcherType)type latency:(NSTimeInterval)latency andCapacity:(size_t)capacity
+{
+	/// The ring has a single writer, so shards must hand over their batches one at a time.
+	if ( type & CBHFileSystemWatcherType_shardByDevice ) { type |= CBHFileSystemWatcherType_orderedShards; }
+
+	if ( self = [super initWithPaths:paths type:type andLatency:latency] )
+	{
+		_ring = [[_CBHFileSystemEventRing alloc] initOwnerWithName:name roots:paths andCapacity:capacity];
+		if ( !_ring ) { return nil; }
+	}
+
+	return self;
+}
+
+
+#pragma mark - Properties
+
+- (NSString *)name
+{
+	return [_ring name];
+}
+
+- (size_t)capacity
+{
+	return [_ring capacity];
+}
+
+- (NSUInteger)readerCount
+{
+	return [_ring readerCount];
+}
+
+
+#pragma mark - Event
+
+- (void)triggerEventsWithCount:(size_t)count paths:(const char * const *)paths flags:(const FSEventStreamEventFlags *)flags andIds:(const FSEventStreamEventId *)ids
+{
+	[_ring writeEventsWithCount:count paths:paths flags:flags andIds:ids];
+}
+
+@end
@@ -25,3 +25,5 @@ FOUNDATION_EXPORT const unsigned char CBHFileSystemEventKitVersionString[];
 
 #import <CBHFileSystemEventKit/CBHFileSystemEvent.h>
 #import <CBHFileSystemEventKit/CBHFileSystemWatcher.h>
+#import <CBHFileSystemEventKit/CBHFileSystemEventBroadcaster.h>
+#import <CBHFileSystemEventKit/CBHFileSystemEventReader.h>
@@ -0,0 +1,143 @@
+//  CBHFileSystemEventReader.h
+//  CBHFileSystemEventKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+@import Foundation;
+
+#import <CBHFileSystemEventKit/CBHFileSystemWatcher.h>
+
+@class CBHFileSystemEvent;
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// The type of block expected by a reader which handles events in batches.
+typedef void (^CBHFileSystemEventReaderBatchBlock)(NSArray<CBHFileSystemEvent *> *events);
+
+/** A lightweight client of a `CBHFileSystemEventBroadcaster`, possibly in another process.
+ *
+ * Readers do no file system watching of their own; they attach to the shared memory of a broadcaster by name and turn
+ * its records back into `CBHFileSystemEvent`s. A reader which falls too far behind receives a
+ * `CBHFileSystemEventType_mustScanSubDirs | CBHFileSystemEventType_userDropped` event for each watched path instead of
+ * the events it missed.
+ *
+ * The same events are delivered once the broadcaster has gone away, after which the reader is detached. A deallocated
+ * broadcaster tells its readers straight away; one whose process exited is noticed on the next read. A detached reader
+ * attaches to the next broadcaster with the same name once that broadcaster publishes, and delivers all it has published.
+ *
+ * @author              Christian Huxtable <chris@huxtable.ca>
+ * @version             1.0
+ */
+@interface CBHFileSystemEventReader : NSObject
+
+#pragma mark - Factories
+
+/**
+ * @name Factories
+ */
+
+/** Creates and returns a reader which delivers events one at a time on the main queue.
+ *
+ * @param name          The name of the broadcaster to attach to.
+ * @param block         The callback that occurs for each event.
+ *
+ * @return              The reader, or `nil` if the broadcaster could not be attached to.
+ */
++ (nullable instancetype)readerWithName:(NSString *)name andBlock:(CBHFileSystemWatcherBlock)block;
+
+/** Creates and returns a reader which delivers events in batches on the main queue.
+ *
+ * @param name          The name of the broadcaster to attach to.
+ * @param block         The callback that occurs for each batch of events.
+ *
+ * @return              The reader, or `nil` if the broadcaster could not be attached to.
+ */
++ (nullable instancetype)readerWithName:(NSString *)name andBatchBlock:(CBHFileSystemEventReaderBatchBlock)block;
+
+
+#pragma mark - Initializers
+
+/**
+ * @name Initializers
+ */
+
+/** Initializes a newly allocated reader which is only read from with `readEvents`.
+ *
+ * @param name          The name of the broadcaster to attach to.
+ *
+ * @return              The initialized reader, or `nil` if the broadcaster could not be attached to.
+ */
+- (nullable instancetype)initWithName:(NSString *)name;
+
+/** Initializes a newly allocated reader.
+ *
+ * @param name          The name of the broadcaster to attach to.
+ * @param block         The callback that occurs for each batch of events once reading has started.
+ *
+ * @return              The initialized reader, or `nil` if the broadcaster could not be attached to.
+ */
+- (nullable instancetype)initWithName:(NSString *)name andBatchBlock:(nullable CBHFileSystemEventReaderBatchBlock)block NS_DESIGNATED_INITIALIZER;
+
+
+#pragma mark - Properties
+
+/**
+ * @name Properties
+ */
+
+/// The name of the broadcaster.
+@property (nonatomic, readonly) NSString *name;
+
+/// The paths the broadcaster is watching.
+@property (nonatomic, readonly) NSArray<NSString *> *paths;
+
+/// Indicates if the reader is currently delivering events to its block.
+@property (nonatomic, readonly) BOOL isReading;
+
+/// Indicates if the reader is attached to a live broadcaster.
+@property (nonatomic, readonly) BOOL isAttached;
+
+
+#pragma mark - Reading
+
+/** Starts delivering events to the receiver's block as they are published.
+ *
+ * @return              The receiver if successful, or `nil` if it fails or has no block.
+ */
+- (nullable instancetype)startReading;
+
+/// Stops delivering events to the receiver's block.
+- (void)stopReading;
+
+/** Reads every event published since the last read.
+ *
+ * @return              The events, in the order they were published.
+ */
+- (NSArray<CBHFileSystemEvent *> *)readEvents;
+
+
+#pragma mark - Unavailable
+
+/**
+* @name Unavailable
+*/
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
+
+NS_ASSUME_NONNULL_END
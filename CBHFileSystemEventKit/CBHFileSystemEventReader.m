@@ -0,0 +1,158 @@
+//  CBHFileSystemEventReader.m
+//  CBHFileSystemEventKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#import "CBHFileSystemEventReader.h"
+
+#import "CBHFileSystemEvent.h"
+
+#import "_CBHFileSystemEventRing.h"
+
+#import <notify.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface CBHFileSystemEventReader ()
+{
+	_CBHFileSystemEventRing *_ring;
+	CBHFileSystemEventReaderBatchBlock __nullable _block;
+
+	BOOL _isReading;
+	int _token;
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
+
+
+@implementation CBHFileSystemEventReader
+
+#pragma mark - Factories
+
++ (instancetype)readerWithName:(NSString *)name andBlock:(CBHFileSystemWatcherBlock)block
+{
+	return [self readerWithName:name andBatchBlock:^(NSArray<CBHFileSystemEvent *> *events) {
+		for (CBHFileSystemEvent *event in events) { block(event); }
+	}];
+}
+
++ (instancetype)readerWithName:(NSString *)name andBatchBlock:(CBHFileSystemEventReaderBatchBlock)block
+{
+	return [[[self alloc] initWithName:name andBatchBlock:block] startReading];
+}
+
+
+#pragma mark - Initializers
+
+- (instancetype)initWithName:(NSString *)name
+{
+	return [self initWithName:name andBatchBlock:nil];
+}
+
+- (instancetype)initWithName:(NSString *)name andBatchBlock:(CBHFileSystemEventReaderBatchBlock)block
+{
+	if ( self = [super init] )
+	{
+		_ring = [[_CBHFileSystemEventRing alloc] initReaderWithName:name];
+		if ( !_ring ) { return nil; }
+
+		_block = block;
+		_isReading = NO;
+	}
+
+	return self;
+}
+
+
+#pragma mark - Destructor
+
+- (void)dealloc
+{
+	[self stopReading];
+}
+
+
+#pragma mark - Properties
+
+@synthesize isReading = _isReading;
+
+- (NSString *)name
+{
+	return [_ring name];
+}
+
+- (NSArray<NSString *> *)paths
+{
+	return [_ring roots];
+}
+
+- (BOOL)isAttached
+{
+	return [_ring isAttached];
+}
+
+
+#pragma mark - Reading
+
+- (instancetype)startReading
+{
+	if ( _isReading ) { return self; }
+	if ( !_block ) { return nil; }
+
+	__weak CBHFileSystemEventReader *weakSelf = self;
+	uint32_t status = notify_register_dispatch([[_ring notificationName] UTF8String], &_token, dispatch_get_main_queue(), ^(int token) {
+		[weakSelf deliverEvents];
+	});
+	if ( status != NOTIFY_STATUS_OK ) { return nil; }
+
+	_isReading = YES;
+
+	/// Pick up anything published between attaching and registering.
+	dispatch_async(dispatch_get_main_queue(), ^{
+		[weakSelf deliverEvents];
+	});
+
+	return self;
+}
+
+- (void)stopReading
+{
+	if ( !_isReading ) { return; }
+
+	notify_cancel(_token);
+	_isReading = NO;
+}
+
+- (NSArray<CBHFileSystemEvent *> *)readEvents
+{
+	return [_ring readEventsWithObject:nil];
+}
+
+
+#pragma mark - Delivery
+
+- (void)deliverEvents
+{
+	if ( !_isReading || !_block ) { return; }
+
+	NSArray<CBHFileSystemEvent *> *events = [self readEvents];
+	if ( [events count] > 0 ) { _block(events); }
+}
+
+@end
@@ -30,6 +30,13 @@ typedef void (^CBHFileSystemWatcherBlock)(CBHFileSystemEvent *event);
 /** Options that can be passed to the initialization and factory methods to modify the behaviour of the watcher being created.
  *
  *  Note: Built around `FSEventStreamCreateFlags`. `kFSEventStreamCreateFlagUseCFTypes` is *NOT* supported.
+ *
+ *  `CBHFileSystemWatcherType_shardByDevice` and `CBHFileSystemWatcherType_orderedShards` are not FSEvents flags. When
+ *  sharding, the paths are grouped by the device they live on and each device gets its own stream and its own serial
+ *  queue, so a storm of events on one volume does not hold up delivery for the others. Events are then delivered on those
+ *  queues, concurrently across devices, unless `CBHFileSystemWatcherType_orderedShards` is also given, in which case
+ *  batches from every device are delivered one at a time in the order they arrive. Stopping a sharded watcher, including
+ *  by deallocating it, waits for running handlers to return; see `stopWatching`.
  */
 typedef NS_OPTIONS(uint64_t, CBHFileSystemWatcherType) {
 	CBHFileSystemWatcherType_default                                                               = kFSEventStreamCreateFlagNone,
@@ -39,7 +46,10 @@ typedef NS_OPTIONS(uint64_t, CBHFileSystemWatcherType) {
 	CBHFileSystemWatcherType_ignoreSelf                                                            = kFSEventStreamCreateFlagIgnoreSelf,
 	CBHFileSystemWatcherType_fileEvents                                                            = kFSEventStreamCreateFlagFileEvents,
 	CBHFileSystemWatcherType_markSelf                                                              = kFSEventStreamCreateFlagMarkSelf,
-	CBHFileSystemWatcherType_useExtendedData  __OSX_AVAILABLE_STARTING(__MAC_10_13, __IPHONE_11_0) = kFSEventStreamCreateFlagUseExtendedData
+	CBHFileSystemWatcherType_useExtendedData  __OSX_AVAILABLE_STARTING(__MAC_10_13, __IPHONE_11_0) = kFSEventStreamCreateFlagUseExtendedData,
+
+	CBHFileSystemWatcherType_shardByDevice                                                         = 1ULL << 32,
+	CBHFileSystemWatcherType_orderedShards                                                         = 1ULL << 33
 };
 
 
@@ -260,7 +270,12 @@ typedef NS_OPTIONS(uint64_t, CBHFileSystemWatcherType) {
  */
 - (nullable instancetype)startWatching;
 
-/// Stops the receiver from watching for file system events.
+/** Stops the receiver from watching for file system events. Events still waiting out the latency are delivered first.
+ *
+ *  Note: When sharded, this blocks until any handler already running on a shard queue has returned, so nothing is
+ *  delivered once it returns. Handlers must therefore not wait on the thread which stops the watcher, for instance with
+ *  `dispatch_sync` to the main queue, or the two will deadlock. Stopping from inside a handler is safe.
+ */
 - (void)stopWatching;
 
 /// Asynchronously flushes out any events that have occurred but have not yet been delivered due to the latency parameter.
@@ -1,4 +1,4 @@
-//  CBHFileSystemWatcher.m
+//  CBHFileSystemWatcher.mm
 //  CBHFileSystemEventKit
 //
 //  Created by Christian Huxtable <chris@huxtable.ca>, November 2019.
@@ -23,12 +23,41 @@
 
 #import "_CBHFileSystemWatcherObserver.h"
 #import "_CBHFileSystemWatcherBlock.h"
+#import "_CBHFileSystemWatcherShard.h"
+
+#import "CBHEventPipeline.hpp"
+#import "CBHDeviceShards.hpp"
 
 @import CoreServices.FSEvents;
 
 
 #define CBHFileSystemWatcher_defaultLatency 3.0
 
+/// The options which are passed through to FSEvents, as opposed to those interpreted by the watcher.
+#define CBHFileSystemWatcher_streamFlags(type) ((FSEventStreamCreateFlags)((type) & 0xFFFFFFFFULL))
+
+
+namespace
+{
+	/// Reads batches in the layout FSEvents delivers them.
+	using _CBHFileSystemWatcherSource = cbh::ParallelArraySource<FSEventStreamEventFlags, FSEventStreamEventId>;
+
+	/// Hands each event to the watcher as a `CBHFileSystemEvent`, released as soon as the handler is done with it.
+	struct _CBHFileSystemWatcherSink
+	{
+		__unsafe_unretained CBHFileSystemWatcher *watcher;
+		__unsafe_unretained id object;
+
+		void operator()(const cbh::Event &event) const
+		{
+			NSString *path = [[NSString alloc] initWithCString:event.path encoding:NSUTF8StringEncoding];
+			[watcher triggerEvent:[[CBHFileSystemEvent alloc] initWithPath:path type:event.flags eventId:event.eventId andObject:object]];
+		}
+	};
+
+	using _CBHFileSystemWatcherPipeline = cbh::EventPipeline<_CBHFileSystemWatcherSource, cbh::AcceptAll, cbh::NoCoalescing, _CBHFileSystemWatcherSink>;
+}
+
 
 void fsEventCallback(ConstFSEventStreamRef streamRef, void *clientCallBackInfo, size_t numEvents, void *eventPaths, const FSEventStreamEventFlags eventFlags[], const FSEventStreamEventId eventIds[]);
 
@@ -129,6 +158,7 @@ void fsEventCallback(ConstFSEventStreamRef streamRef, void *clientCallBackInfo,
 		_latency = latency;
 
 		_stream = nil;
+		_shards = nil;
 	}
 
 	return self;
@@ -148,6 +178,7 @@ void fsEventCallback(ConstFSEventStreamRef streamRef, void *clientCallBackInfo,
 @synthesize paths = _paths;
 @synthesize type = _type;
 @synthesize latency = _latency;
+@synthesize shards = _shards;
 
 - (id)object
 {
@@ -159,12 +190,13 @@ void fsEventCallback(ConstFSEventStreamRef streamRef, void *clientCallBackInfo,
 
 - (instancetype)startWatching
 {
-	if ( _stream ) { return self; }
+	if ( _stream || _shards ) { return self; }
+	if ( _type & CBHFileSystemWatcherType_shardByDevice ) { return [self startWatchingShards]; }
 
 	CFArrayRef cfPaths = (__bridge CFArrayRef)_paths;
 	FSEventStreamContext context = {0, (__bridge void *)self, NULL, NULL, NULL};
 
-	_stream = FSEventStreamCreate(NULL, &fsEventCallback, &context, cfPaths, kFSEventStreamEventIdSinceNow, (CFAbsoluteTime)_latency, (FSEventStreamCreateFlags)_type);
+	_stream = FSEventStreamCreate(NULL, &fsEventCallback, &context, cfPaths, kFSEventStreamEventIdSinceNow, (CFAbsoluteTime)_latency, CBHFileSystemWatcher_streamFlags(_type));
 
 	FSEventStreamScheduleWithRunLoop(_stream, CFRunLoopGetCurrent(), kCFRunLoopDefaultMode);
 	if ( !FSEventStreamStart(_stream) ) { return nil; } /// TODO: Force this to fail for testing. Now?
@@ -172,8 +204,47 @@ void fsEventCallback(ConstFSEventStreamRef streamRef, void *clientCallBackInfo,
 	return self;
 }
 
+- (instancetype)startWatchingShards
+{
+	std::vector<std::string> paths;
+	paths.reserve([_paths count]);
+	for (NSString *path in _paths) { paths.emplace_back([path fileSystemRepresentation]); }
+
+	dispatch_queue_t target = nil;
+	if ( _type & CBHFileSystemWatcherType_orderedShards )
+	{
+		target = dispatch_queue_create("ca.huxtable.CBHFileSystemEventKit.ordered", DISPATCH_QUEUE_SERIAL);
+	}
+
+	NSMutableArray<_CBHFileSystemWatcherShard *> *shards = [NSMutableArray array];
+	for (const cbh::DeviceShard &deviceShard : cbh::shardByDevice(paths))
+	{
+		NSMutableArray<NSString *> *shardPaths = [NSMutableArray arrayWithCapacity:deviceShard.indices.size()];
+		for (std::size_t index : deviceShard.indices) { [shardPaths addObject:_paths[index]]; }
+
+		_CBHFileSystemWatcherShard *shard = [[_CBHFileSystemWatcherShard alloc] initWithWatcher:self paths:shardPaths device:deviceShard.device andTargetQueue:target];
+		if ( ![shard startWithLatency:_latency andFlags:CBHFileSystemWatcher_streamFlags(_type)] )
+		{
+			for (_CBHFileSystemWatcherShard *started in shards) { [started stop]; }
+			return nil;
+		}
+
+		[shards addObject:shard];
+	}
+
+	_shards = shards;
+
+	return self;
+}
+
 - (void)stopWatching
 {
+	if ( _shards )
+	{
+		for (_CBHFileSystemWatcherShard *shard in _shards) { [shard stop]; }
+		_shards = nil;
+	}
+
 	if ( !_stream ) { return; }
 
 	FSEventStreamFlushSync(_stream);
@@ -186,12 +257,13 @@ void fsEventCallback(ConstFSEventStreamRef streamRef, void *clientCallBackInfo,
 
 - (void)flushEvents
 {
-	FSEventStreamFlushAsync(_stream);
+	for (_CBHFileSystemWatcherShard *shard in _shards) { [shard flush]; }
+	if ( _stream ) { FSEventStreamFlushAsync(_stream); }
 }
 
 - (BOOL)isWatching
 {
-	return !!_stream;
+	return ( _stream || _shards );
 }
 
 
@@ -213,6 +285,8 @@ void fsEventCallback(ConstFSEventStreamRef streamRef, void *clientCallBackInfo,
 - (NSString *)description
 {
 	/// TODO: Improve description
+	if ( _shards ) { return [_shards componentsJoinedByString:@"\n"]; }
+
 	return (__bridge NSString *)CFAutorelease(FSEventStreamCopyDescription(_stream));
 }
 
@@ -224,6 +298,18 @@ void fsEventCallback(ConstFSEventStreamRef streamRef, void *clientCallBackInfo,
 
 #pragma mark - Event
 
+- (void)triggerEventsWithCount:(size_t)count paths:(const char * const *)paths flags:(const FSEventStreamEventFlags *)flags andIds:(const FSEventStreamEventId *)ids
+{
+	id object = [self object];
+
+	/// Keeps anything autoreleased by handlers from piling up across a large batch.
+	@autoreleasepool
+	{
+		_CBHFileSystemWatcherPipeline pipeline(_CBHFileSystemWatcherSink{self, object});
+		pipeline({count, paths, flags, ids});
+	}
+}
+
 - (void)triggerEvent:(CBHFileSystemEvent *)event
 {
 	NSAssert(NO, @"The method `triggerEvent:` must be overridden by all subclasses and should never be called.");
@@ -237,10 +323,5 @@ void fsEventCallback(ConstFSEventStreamRef streamRef, void *clientCallBackInfo,
 void fsEventCallback(ConstFSEventStreamRef streamRef, void *info, size_t numEvents, void *eventPaths, const FSEventStreamEventFlags eventFlags[], const FSEventStreamEventId eventIds[])
 {
 	CBHFileSystemWatcher *watcher = (__bridge CBHFileSystemWatcher *)info;
-	char **paths = eventPaths;
-
-	for (uint64_t i = 0; i < numEvents; ++i)
-	{
-		[watcher triggerEvent:[CBHFileSystemEvent eventWithPath:[NSString stringWithCString: paths[i] encoding:NSUTF8StringEncoding] type:eventFlags[i] eventId:eventIds[i] andObject:[watcher object]]];
-	}
+	[watcher triggerEventsWithCount:numEvents paths:(const char * const *)eventPaths flags:eventFlags andIds:eventIds];
 }
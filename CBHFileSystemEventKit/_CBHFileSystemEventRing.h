@@ -0,0 +1,112 @@
+//  _CBHFileSystemEventRing.h
+//  CBHFileSystemEventKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+@import Foundation;
+@import CoreServices.FSEvents;
+
+@class CBHFileSystemEvent;
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/** A single producer, multiple consumer ring of compact event records living in POSIX shared memory.
+ *
+ * The owner writes records without ever waiting on readers. Each reader claims a cursor slot in the shared header and
+ * detects when the owner has lapped it, in which case the missed records are replaced with a single dropped event per
+ * watched root, mirroring how FSEvents itself reports dropped events.
+ *
+ * A reader also reports dropped events when its owner closes the ring or exits, then detaches. Detached readers attach to
+ * the next ring published under the same name the next time they read.
+ */
+@interface _CBHFileSystemEventRing : NSObject
+
+#pragma mark - Initializers
+
+/** Creates the shared memory region and initializes it as the owner.
+ *
+ * A name left behind by an owner which has exited is reclaimed. A name belonging to a live owner is not, and `errno` is
+ * set to `EEXIST`.
+ *
+ * @param name          The name of the ring. Must be short enough to form a valid shared memory name.
+ * @param roots         The paths being watched by the owner.
+ * @param capacity      The number of bytes available for records. Rounded up to a power of two, at most 2 GiB.
+ *
+ * @return              The initialized ring, or `nil` if the capacity is too large or the shared memory could not be created.
+ */
+- (nullable instancetype)initOwnerWithName:(NSString *)name roots:(NSArray<NSString *> *)roots andCapacity:(size_t)capacity;
+
+/** Attaches to an existing shared memory region and claims a reader cursor.
+ *
+ * @param name          The name of the ring.
+ *
+ * @return              The initialized ring, or `nil` if the ring does not exist, has no live owner, or has no free reader cursors.
+ */
+- (nullable instancetype)initReaderWithName:(NSString *)name;
+
+
+#pragma mark - Properties
+
+/// The name of the ring.
+@property (nonatomic, readonly) NSString *name;
+
+/// The name used to signal that new records have been published.
+@property (nonatomic, readonly) NSString *notificationName;
+
+/// The paths being watched by the owner.
+@property (nonatomic, readonly) NSArray<NSString *> *roots;
+
+/// The number of bytes available for records.
+@property (nonatomic, readonly) size_t capacity;
+
+/// The number of readers currently attached.
+@property (nonatomic, readonly) NSUInteger readerCount;
+
+/// Indicates if the receiver is mapped to a ring. Only ever `NO` for a reader whose owner has gone away.
+@property (nonatomic, readonly) BOOL isAttached;
+
+
+#pragma mark - Writing
+
+/** Publishes a batch of events to all readers. Only valid on the owner.
+ *
+ * @param count         The number of events in the batch.
+ * @param paths         The paths of the events.
+ * @param flags         The flags of the events.
+ * @param ids           The ids of the events.
+ */
+- (void)writeEventsWithCount:(size_t)count paths:(const char * _Nonnull const * _Nonnull)paths flags:(const FSEventStreamEventFlags *)flags andIds:(const FSEventStreamEventId *)ids;
+
+
+#pragma mark - Reading
+
+/** Reads every record published since the last read. Only valid on a reader.
+ *
+ * @param object        The context object for the events.
+ *
+ * @return              The events, in the order they were published.
+ */
+- (NSArray<CBHFileSystemEvent *> *)readEventsWithObject:(nullable id)object;
+
+
+#pragma mark - Unavailable
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,562 @@
+//  _CBHFileSystemEventRing.m
+//  CBHFileSystemEventKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#import "_CBHFileSystemEventRing.h"
+
+#import "CBHFileSystemEvent.h"
+
+#import <stdatomic.h>
+#import <sys/mman.h>
+#import <sys/stat.h>
+#import <fcntl.h>
+#import <unistd.h>
+#import <signal.h>
+#import <errno.h>
+#import <notify.h>
+
+
+#define _CBHFileSystemEventRing_magic 0x43424852
+#define _CBHFileSystemEventRing_version 3
+
+#define _CBHFileSystemEventRing_readerCapacity 32
+#define _CBHFileSystemEventRing_rootsCapacity 4096
+#define _CBHFileSystemEventRing_minimumCapacity 65536
+#define _CBHFileSystemEventRing_maximumCapacity (1ULL << 31)
+#define _CBHFileSystemEventRing_dataAlignment 64
+#define _CBHFileSystemEventRing_recordAlignment 8
+
+#define _CBHFileSystemEventRing_notificationPrefix @"ca.huxtable.CBHFileSystemEventKit.broadcast."
+
+
+/// A reader cursor. A `pid` of zero marks the slot as free.
+typedef struct {
+	_Atomic(pid_t) pid;
+	_Atomic(uint64_t) cursor;
+} _CBHFileSystemEventRingReader;
+
+/// The shared header. Offsets are monotonic byte counts and are masked with `capacity - 1` to find a position in the data.
+typedef struct {
+	_Atomic(uint32_t) magic;
+	uint32_t version;
+	uint64_t capacity;
+
+	_Atomic(pid_t) owner;
+	_Atomic(uint32_t) isClosed;
+
+	_Atomic(uint64_t) reserved;
+	_Atomic(uint64_t) head;
+
+	_CBHFileSystemEventRingReader readers[_CBHFileSystemEventRing_readerCapacity];
+
+	uint32_t rootsLength;
+	char roots[_CBHFileSystemEventRing_rootsCapacity];
+} _CBHFileSystemEventRingHeader;
+
+/// A record, followed by its NUL terminated path. A `length` of zero marks padding up to the end of the data.
+typedef struct {
+	uint64_t eventId;
+	uint64_t flags;
+	uint32_t size;
+	uint32_t length;
+} _CBHFileSystemEventRingRecord;
+
+
+static inline size_t _CBHFileSystemEventRing_align(size_t value, size_t alignment)
+{
+	return (value + alignment - 1) & ~(alignment - 1);
+}
+
+static inline size_t _CBHFileSystemEventRing_dataOffset(void)
+{
+	return _CBHFileSystemEventRing_align(sizeof(_CBHFileSystemEventRingHeader), _CBHFileSystemEventRing_dataAlignment);
+}
+
+/// Whether the owner is still publishing to the ring, as opposed to having closed it or exited.
+static inline BOOL _CBHFileSystemEventRing_isOwnerAlive(_CBHFileSystemEventRingHeader *header)
+{
+	if ( atomic_load_explicit(&header->isClosed, memory_order_acquire) ) { return NO; }
+
+	pid_t owner = atomic_load_explicit(&header->owner, memory_order_acquire);
+	return ( owner != 0 && !(kill(owner, 0) != 0 && errno == ESRCH) );
+}
+
+/** Copies bytes into the data a word at a time with relaxed atomic stores. Readers copy concurrently and rely on the
+ * `reserved` check to discard what they tore, so the copies themselves must not be data races. `destination` must be
+ * word aligned; the last word is padded with zeros.
+ */
+static inline void _CBHFileSystemEventRing_store(uint8_t *destination, const void *source, size_t length)
+{
+	const uint8_t *bytes = source;
+
+	for (size_t offset = 0; offset < length; offset += sizeof(uint64_t))
+	{
+		uint64_t word = 0;
+		memcpy(&word, bytes + offset, MIN(sizeof(word), length - offset));
+		atomic_store_explicit((_Atomic(uint64_t) *)(void *)(destination + offset), word, memory_order_relaxed);
+	}
+}
+
+/// Copies bytes out of the data a word at a time with relaxed atomic loads. The counterpart of `_CBHFileSystemEventRing_store`.
+static inline void _CBHFileSystemEventRing_load(void *destination, const uint8_t *source, size_t length)
+{
+	uint8_t *bytes = destination;
+
+	for (size_t offset = 0; offset < length; offset += sizeof(uint64_t))
+	{
+		uint64_t word = atomic_load_explicit((_Atomic(uint64_t) *)(void *)(source + offset), memory_order_relaxed);
+		memcpy(bytes + offset, &word, MIN(sizeof(word), length - offset));
+	}
+}
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface _CBHFileSystemEventRing ()
+{
+	NSString *_name;
+	NSString *_notificationName;
+	NSArray<NSString *> *_roots;
+	size_t _capacity;
+
+	BOOL _isOwner;
+	NSInteger _slot;
+
+	_CBHFileSystemEventRingHeader * __nullable _header;
+	uint8_t * __nullable _data;
+	size_t _mapLength;
+
+	NSMutableData *_pathBuffer;
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
+
+
+@implementation _CBHFileSystemEventRing
+
+#pragma mark - Initializers
+
+- (instancetype)initOwnerWithName:(NSString *)name roots:(NSArray<NSString *> *)roots andCapacity:(size_t)capacity
+{
+	if ( !(self = [super init]) ) { return nil; }
+
+	_name = [name copy];
+	_notificationName = [_CBHFileSystemEventRing_notificationPrefix stringByAppendingString:_name];
+	_roots = [roots copy];
+	_isOwner = YES;
+	_slot = -1;
+
+	/// Record sizes are stored in 32 bits, and anything larger would never be reached by doubling anyway.
+	if ( capacity > _CBHFileSystemEventRing_maximumCapacity ) { return nil; }
+
+	_capacity = _CBHFileSystemEventRing_minimumCapacity;
+	while ( _capacity < capacity ) { _capacity <<= 1; }
+
+	NSMutableData *encodedRoots = [NSMutableData data];
+	for (NSString *root in _roots)
+	{
+		const char *string = [root fileSystemRepresentation];
+		[encodedRoots appendBytes:string length:strlen(string) + 1];
+	}
+	if ( [encodedRoots length] > _CBHFileSystemEventRing_rootsCapacity ) { return nil; }
+
+	const char *sharedName = [[self sharedName] UTF8String];
+
+	int descriptor = shm_open(sharedName, O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+	if ( descriptor < 0 && errno == EEXIST && [self reclaimSharedName:sharedName] )
+	{
+		descriptor = shm_open(sharedName, O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+	}
+	if ( descriptor < 0 ) { return nil; }
+
+	_mapLength = _CBHFileSystemEventRing_dataOffset() + _capacity;
+	if ( ftruncate(descriptor, (off_t)_mapLength) != 0 )
+	{
+		close(descriptor);
+		shm_unlink(sharedName);
+		return nil;
+	}
+
+	void *map = mmap(NULL, _mapLength, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+	close(descriptor);
+
+	if ( map == MAP_FAILED )
+	{
+		shm_unlink(sharedName);
+		return nil;
+	}
+
+	/// The region is zero filled by `ftruncate`, so only the non-zero fields need writing.
+	_header = map;
+	_data = (uint8_t *)map + _CBHFileSystemEventRing_dataOffset();
+
+	atomic_store_explicit(&_header->owner, getpid(), memory_order_release);
+	_header->version = _CBHFileSystemEventRing_version;
+	_header->capacity = _capacity;
+	_header->rootsLength = (uint32_t)[encodedRoots length];
+	memcpy(_header->roots, [encodedRoots bytes], [encodedRoots length]);
+
+	atomic_store_explicit(&_header->magic, _CBHFileSystemEventRing_magic, memory_order_release);
+
+	return self;
+}
+
+- (instancetype)initReaderWithName:(NSString *)name
+{
+	if ( !(self = [super init]) ) { return nil; }
+
+	_name = [name copy];
+	_notificationName = [_CBHFileSystemEventRing_notificationPrefix stringByAppendingString:_name];
+	_isOwner = NO;
+	_slot = -1;
+	_pathBuffer = [NSMutableData data];
+
+	if ( ![self attachFromStart:NO] ) { return nil; }
+
+	return self;
+}
+
+
+#pragma mark - Destructor
+
+- (void)dealloc
+{
+	if ( _isOwner && _header )
+	{
+		/// Mark the ring finished before the name can be reused so no reader keeps reading a mapping nobody writes to.
+		atomic_store_explicit(&_header->isClosed, 1, memory_order_release);
+
+		/// No other owner can have taken the name while this process is alive, so it is still this ring's to remove.
+		shm_unlink([[self sharedName] UTF8String]);
+		notify_post([_notificationName UTF8String]);
+	}
+
+	[self detach];
+}
+
+
+#pragma mark - Properties
+
+@synthesize name = _name;
+@synthesize notificationName = _notificationName;
+@synthesize roots = _roots;
+@synthesize capacity = _capacity;
+
+- (BOOL)isAttached
+{
+	return ( _header != NULL );
+}
+
+- (NSUInteger)readerCount
+{
+	NSUInteger count = 0;
+
+	for (NSUInteger i = 0; i < _CBHFileSystemEventRing_readerCapacity; ++i)
+	{
+		if ( atomic_load_explicit(&_header->readers[i].pid, memory_order_relaxed) != 0 ) { ++count; }
+	}
+
+	return count;
+}
+
+
+#pragma mark - Writing
+
+- (void)writeEventsWithCount:(size_t)count paths:(const char * const *)paths flags:(const FSEventStreamEventFlags *)flags andIds:(const FSEventStreamEventId *)ids
+{
+	if ( !_isOwner || count == 0 ) { return; }
+
+	uint64_t head = atomic_load_explicit(&_header->head, memory_order_relaxed);
+	uint64_t mask = _capacity - 1;
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		size_t length = strlen(paths[i]);
+		size_t size = _CBHFileSystemEventRing_align(sizeof(_CBHFileSystemEventRingRecord) + length + 1, _CBHFileSystemEventRing_recordAlignment);
+		if ( length == 0 || size > _capacity / 2 ) { continue; }
+
+		size_t offset = head & mask;
+		size_t remaining = _capacity - offset;
+		size_t padding = ( remaining < size ) ? remaining : 0;
+
+		/// Announce the bytes about to be overwritten before touching them so readers can detect a torn record.
+		atomic_store_explicit(&_header->reserved, head + padding + size, memory_order_relaxed);
+		atomic_thread_fence(memory_order_release);
+
+		if ( padding )
+		{
+			/// Readers skip tails too small for a record without needing a marker.
+			if ( padding >= sizeof(_CBHFileSystemEventRingRecord) )
+			{
+				_CBHFileSystemEventRingRecord marker = {0, 0, (uint32_t)padding, 0};
+				_CBHFileSystemEventRing_store(_data + offset, &marker, sizeof(marker));
+			}
+
+			head += padding;
+			offset = 0;
+		}
+
+		_CBHFileSystemEventRingRecord record = {ids[i], flags[i], (uint32_t)size, (uint32_t)length};
+		_CBHFileSystemEventRing_store(_data + offset, &record, sizeof(record));
+		_CBHFileSystemEventRing_store(_data + offset + sizeof(record), paths[i], length + 1);
+
+		head += size;
+	}
+
+	atomic_store_explicit(&_header->head, head, memory_order_release);
+	notify_post([_notificationName UTF8String]);
+}
+
+
+#pragma mark - Reading
+
+- (NSArray<CBHFileSystemEvent *> *)readEventsWithObject:(id)object
+{
+	if ( _isOwner ) { return @[]; }
+
+	NSMutableArray<CBHFileSystemEvent *> *events = [NSMutableArray array];
+
+	/// A detached reader follows the name to the next owner, reading its ring from the start as none of it has been seen.
+	if ( !_header && ![self attachFromStart:YES] ) { return events; }
+
+	/// Checked before reading so that everything the owner published before going away is still delivered.
+	BOOL isOwnerGone = !_CBHFileSystemEventRing_isOwnerAlive(_header);
+	BOOL isDropped = [self readRecordsIntoEvents:events withObject:object];
+
+	if ( isOwnerGone )
+	{
+		/// Whatever happened between this owner going and the next arriving was never published.
+		if ( !isDropped ) { [self addDroppedEventsToEvents:events withObject:object]; }
+
+		[self detach];
+		if ( [self attachFromStart:YES] ) { [self readRecordsIntoEvents:events withObject:object]; }
+	}
+
+	return events;
+}
+
+/** Reads every record published since the last read, or dropped events in their place if the reader has been lapped.
+ *
+ * @param events        The array to add the events to.
+ * @param object        The context object for the events.
+ *
+ * @return              `YES` if the reader was lapped, otherwise `NO`.
+ */
+- (BOOL)readRecordsIntoEvents:(NSMutableArray<CBHFileSystemEvent *> *)events withObject:(id)object
+{
+	_CBHFileSystemEventRingReader *reader = &_header->readers[_slot];
+	uint64_t cursor = atomic_load_explicit(&reader->cursor, memory_order_relaxed);
+	uint64_t head = atomic_load_explicit(&_header->head, memory_order_acquire);
+	uint64_t mask = _capacity - 1;
+
+	BOOL isLapped = NO;
+
+	while ( cursor < head )
+	{
+		if ( head - cursor > _capacity ) { isLapped = YES; break; }
+
+		size_t offset = cursor & mask;
+		size_t remaining = _capacity - offset;
+		if ( remaining < sizeof(_CBHFileSystemEventRingRecord) ) { cursor += remaining; continue; }
+
+		_CBHFileSystemEventRingRecord record;
+		_CBHFileSystemEventRing_load(&record, _data + offset, sizeof(record));
+
+		BOOL isValid = ( record.size >= sizeof(_CBHFileSystemEventRingRecord) && record.size <= remaining );
+		isValid = isValid && ( record.length == 0 || (size_t)record.length + 1 <= record.size - sizeof(_CBHFileSystemEventRingRecord) );
+
+		NSString *path = nil;
+		if ( isValid && record.length > 0 )
+		{
+			if ( [_pathBuffer length] < record.length ) { [_pathBuffer setLength:record.length]; }
+			_CBHFileSystemEventRing_load([_pathBuffer mutableBytes], _data + offset + sizeof(record), record.length);
+			path = [[NSString alloc] initWithBytes:[_pathBuffer bytes] length:record.length encoding:NSUTF8StringEncoding];
+		}
+
+		/// If the owner has reserved past this record while it was being copied the copy cannot be trusted.
+		atomic_thread_fence(memory_order_acquire);
+		if ( !isValid || atomic_load_explicit(&_header->reserved, memory_order_relaxed) > cursor + _capacity ) { isLapped = YES; break; }
+
+		if ( path ) { [events addObject:[CBHFileSystemEvent eventWithPath:path type:record.flags eventId:record.eventId andObject:object]]; }
+		cursor += record.size;
+	}
+
+	if ( isLapped )
+	{
+		cursor = atomic_load_explicit(&_header->head, memory_order_acquire);
+		[self addDroppedEventsToEvents:events withObject:object];
+	}
+
+	atomic_store_explicit(&reader->cursor, cursor, memory_order_relaxed);
+
+	return isLapped;
+}
+
+- (void)addDroppedEventsToEvents:(NSMutableArray<CBHFileSystemEvent *> *)events withObject:(id)object
+{
+	for (NSString *root in _roots)
+	{
+		[events addObject:[CBHFileSystemEvent eventWithPath:root type:(CBHFileSystemEventType_mustScanSubDirs | CBHFileSystemEventType_userDropped) eventId:0 andObject:object]];
+	}
+}
+
+
+#pragma mark - Helpers
+
+- (NSString *)sharedName
+{
+	return [@"/" stringByAppendingString:_name];
+}
+
+/** Maps the ring currently published under the receiver's name and claims a reader cursor in it.
+ *
+ * @param fromStart     Whether to read the ring from its first record rather than only what is published from now on.
+ *
+ * @return              `YES` if attached, or `NO` if there is no ring under the name, it has no live owner, or it has no
+ *                      free reader cursors.
+ */
+- (BOOL)attachFromStart:(BOOL)fromStart
+{
+	int descriptor = shm_open([[self sharedName] UTF8String], O_RDWR);
+	if ( descriptor < 0 ) { return NO; }
+
+	struct stat info;
+	if ( fstat(descriptor, &info) != 0 || (size_t)info.st_size < _CBHFileSystemEventRing_dataOffset() )
+	{
+		close(descriptor);
+		return NO;
+	}
+
+	size_t mapLength = (size_t)info.st_size;
+	void *map = mmap(NULL, mapLength, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+	close(descriptor);
+
+	if ( map == MAP_FAILED ) { return NO; }
+
+	_CBHFileSystemEventRingHeader *header = map;
+	BOOL isValid = ( atomic_load_explicit(&header->magic, memory_order_acquire) == _CBHFileSystemEventRing_magic );
+	isValid = isValid && ( header->version == _CBHFileSystemEventRing_version );
+	isValid = isValid && ( _CBHFileSystemEventRing_dataOffset() + header->capacity == mapLength );
+	isValid = isValid && ( header->rootsLength <= _CBHFileSystemEventRing_rootsCapacity );
+
+	/// A ring left behind by an owner which crashed will never be written to again.
+	if ( !isValid || !_CBHFileSystemEventRing_isOwnerAlive(header) )
+	{
+		munmap(map, mapLength);
+		return NO;
+	}
+
+	_header = header;
+	_mapLength = mapLength;
+	_capacity = header->capacity;
+	_data = (uint8_t *)map + _CBHFileSystemEventRing_dataOffset();
+
+	NSMutableArray<NSString *> *roots = [NSMutableArray array];
+	for (size_t offset = 0; offset < header->rootsLength; )
+	{
+		const char *root = header->roots + offset;
+		size_t length = strnlen(root, header->rootsLength - offset);
+
+		[roots addObject:[[NSFileManager defaultManager] stringWithFileSystemRepresentation:root length:length]];
+		offset += length + 1;
+	}
+	_roots = roots;
+
+	if ( ![self claimReaderSlotFromStart:fromStart] )
+	{
+		[self detach];
+		return NO;
+	}
+
+	return YES;
+}
+
+/// Releases the receiver's reader cursor, if any, and unmaps the ring.
+- (void)detach
+{
+	if ( !_header ) { return; }
+
+	if ( _slot >= 0 ) { atomic_store_explicit(&_header->readers[_slot].pid, 0, memory_order_release); }
+	munmap(_header, _mapLength);
+
+	_slot = -1;
+	_header = NULL;
+	_data = NULL;
+}
+
+- (BOOL)reclaimSharedName:(const char *)sharedName
+{
+	int descriptor = shm_open(sharedName, O_RDWR);
+	if ( descriptor < 0 ) { return ( errno == ENOENT ); }
+
+	struct stat info;
+	void *map = MAP_FAILED;
+	if ( fstat(descriptor, &info) == 0 && (size_t)info.st_size >= sizeof(_CBHFileSystemEventRingHeader) )
+	{
+		map = mmap(NULL, sizeof(_CBHFileSystemEventRingHeader), PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+	}
+	close(descriptor);
+
+	/// A region too small to hold a header is still being created by its owner.
+	if ( map == MAP_FAILED ) { errno = EEXIST; return NO; }
+
+	/// Only a ring whose owner has exited may be taken over, and only by whichever process swaps in its own pid first.
+	_CBHFileSystemEventRingHeader *header = map;
+	pid_t owner = atomic_load_explicit(&header->owner, memory_order_acquire);
+	BOOL isClosed = ( atomic_load_explicit(&header->isClosed, memory_order_acquire) != 0 );
+	BOOL isCompatible = ( atomic_load_explicit(&header->magic, memory_order_acquire) != _CBHFileSystemEventRing_magic || header->version == _CBHFileSystemEventRing_version );
+	BOOL isAbandoned = ( isCompatible && owner != 0 && (isClosed || (kill(owner, 0) != 0 && errno == ESRCH)) );
+	BOOL isReclaimed = ( isAbandoned && atomic_compare_exchange_strong_explicit(&header->owner, &owner, getpid(), memory_order_acq_rel, memory_order_relaxed) );
+	munmap(map, sizeof(_CBHFileSystemEventRingHeader));
+
+	if ( !isReclaimed ) { errno = EEXIST; return NO; }
+
+	shm_unlink(sharedName);
+	return YES;
+}
+
+- (BOOL)claimReaderSlotFromStart:(BOOL)fromStart
+{
+	pid_t me = getpid();
+
+	for (NSInteger i = 0; i < _CBHFileSystemEventRing_readerCapacity; ++i)
+	{
+		_CBHFileSystemEventRingReader *reader = &_header->readers[i];
+		pid_t pid = atomic_load_explicit(&reader->pid, memory_order_acquire);
+
+		/// Reclaim slots left behind by readers which exited without detaching.
+		if ( pid != 0 && kill(pid, 0) != 0 && errno == ESRCH )
+		{
+			atomic_compare_exchange_strong_explicit(&reader->pid, &pid, 0, memory_order_acq_rel, memory_order_relaxed);
+			pid = atomic_load_explicit(&reader->pid, memory_order_acquire);
+		}
+
+		if ( pid != 0 ) { continue; }
+		if ( !atomic_compare_exchange_strong_explicit(&reader->pid, &pid, me, memory_order_acq_rel, memory_order_relaxed) ) { continue; }
+
+		atomic_store_explicit(&reader->cursor, ( fromStart ) ? 0 : atomic_load_explicit(&_header->head, memory_order_acquire), memory_order_relaxed);
+		_slot = i;
+
+		return YES;
+	}
+
+	return NO;
+}
+
+@end
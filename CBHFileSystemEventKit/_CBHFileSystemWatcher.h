@@ -16,6 +16,8 @@
 //  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
 //  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 
+@class _CBHFileSystemWatcherShard;
+
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -28,12 +30,39 @@ NS_ASSUME_NONNULL_BEGIN
 	CBHFileSystemWatcherType _type;
 
 	FSEventStreamRef __nullable _stream;
+	NSArray<_CBHFileSystemWatcherShard *> * __nullable _shards;
 }
 
 #pragma mark - Initializers
 
 - (instancetype)initWithPaths:(NSArray<NSString *> *)paths type:(CBHFileSystemWatcherType)type andLatency:(NSTimeInterval)latency;
 
+
+#pragma mark - Properties
+
+/// The shards being watched, one per device, or `nil` if the watcher is not sharded or not watching.
+@property (nonatomic, readonly, nullable) NSArray<_CBHFileSystemWatcherShard *> *shards;
+
+
+#pragma mark - Event
+
+/** Handles a raw batch of events as delivered by the stream. The default implementation creates a `CBHFileSystemEvent` for
+ * each entry and passes it to `triggerEvent:`, inside an autorelease pool scoped to the batch. Subclasses which do not
+ * need event objects may override this instead.
+ *
+ * @param count         The number of events in the batch.
+ * @param paths         The paths of the events. Only valid for the duration of the call.
+ * @param flags         The flags of the events.
+ * @param ids           The ids of the events.
+ */
+- (void)triggerEventsWithCount:(size_t)count paths:(const char * _Nonnull const * _Nonnull)paths flags:(const FSEventStreamEventFlags *)flags andIds:(const FSEventStreamEventId *)ids;
+
+/** Handles a single event. Must be overridden by subclasses which do not override `triggerEventsWithCount:paths:flags:andIds:`.
+ *
+ * @param event         The event to handle.
+ */
+- (void)triggerEvent:(CBHFileSystemEvent *)event;
+
 @end
 
 NS_ASSUME_NONNULL_END
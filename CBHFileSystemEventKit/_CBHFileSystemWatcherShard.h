@@ -0,0 +1,84 @@
+//  _CBHFileSystemWatcherShard.h
+//  CBHFileSystemEventKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+@import Foundation;
+@import CoreServices.FSEvents;
+
+@class CBHFileSystemWatcher;
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/** One device's share of a sharded watcher's paths, with its own stream and serial queue.
+ *
+ * Batches are handed to the watcher with `triggerEventsWithCount:paths:flags:andIds:` on the shard's queue. The stream
+ * retains the shard, and the shard only weakly references its watcher, so batches arriving while the watcher is being
+ * deallocated are dropped.
+ */
+@interface _CBHFileSystemWatcherShard : NSObject
+
+#pragma mark - Initializers
+
+/** Initializes a newly allocated shard.
+ *
+ * @param watcher       The watcher to deliver events to.
+ * @param paths         The paths to watch, all on `device`.
+ * @param device        The device the paths live on.
+ * @param target        The queue to deliver batches through, or `nil` to deliver independently of other shards.
+ *
+ * @return              The initialized shard.
+ */
+- (instancetype)initWithWatcher:(CBHFileSystemWatcher *)watcher paths:(NSArray<NSString *> *)paths device:(uint64_t)device andTargetQueue:(nullable dispatch_queue_t)target NS_DESIGNATED_INITIALIZER;
+
+
+#pragma mark - Properties
+
+/// The paths to watch.
+@property (nonatomic, readonly) NSArray<NSString *> *paths;
+
+/// The device the paths live on.
+@property (nonatomic, readonly) uint64_t device;
+
+
+#pragma mark - Watching
+
+/** Creates and starts the shard's stream.
+ *
+ * @param latency       The number of seconds the stream should wait before delivering events.
+ * @param flags         The flags to create the stream with.
+ *
+ * @return              `YES` if the stream started, otherwise `NO`.
+ */
+- (BOOL)startWithLatency:(NSTimeInterval)latency andFlags:(FSEventStreamCreateFlags)flags;
+
+/** Delivers any pending events, then stops and releases the shard's stream. Once this returns no further batches are
+ * delivered. When called from inside a batch of the same watcher there is no waiting; only later batches are dropped.
+ */
+- (void)stop;
+
+/// Asynchronously flushes out any events that have not yet been delivered.
+- (void)flush;
+
+
+#pragma mark - Unavailable
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
+
+NS_ASSUME_NONNULL_END
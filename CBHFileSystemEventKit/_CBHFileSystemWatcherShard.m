@@ -0,0 +1,168 @@
+//  _CBHFileSystemWatcherShard.m
+//  CBHFileSystemEventKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#import "_CBHFileSystemWatcherShard.h"
+
+#import "CBHFileSystemWatcher.h"
+#import "_CBHFileSystemWatcher.h"
+
+#import <stdatomic.h>
+
+
+/// Identifies a shard queue by the watcher it delivers to, so a shard can tell when it is stopped from inside a batch.
+static char _CBHFileSystemWatcherShard_queueKey;
+
+static void fsShardEventCallback(ConstFSEventStreamRef streamRef, void *info, size_t numEvents, void *eventPaths, const FSEventStreamEventFlags eventFlags[], const FSEventStreamEventId eventIds[]);
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface _CBHFileSystemWatcherShard ()
+{
+	__weak CBHFileSystemWatcher *_watcher;
+	NSArray<NSString *> *_paths;
+	uint64_t _device;
+
+	dispatch_queue_t _queue;
+	FSEventStreamRef __nullable _stream;
+	_Atomic(BOOL) _isStopped;
+}
+
+#pragma mark - Event
+
+- (void)receiveEventsWithCount:(size_t)count paths:(const char * _Nonnull const * _Nonnull)paths flags:(const FSEventStreamEventFlags *)flags andIds:(const FSEventStreamEventId *)ids;
+
+@end
+
+NS_ASSUME_NONNULL_END
+
+
+@implementation _CBHFileSystemWatcherShard
+
+#pragma mark - Initializers
+
+- (instancetype)initWithWatcher:(CBHFileSystemWatcher *)watcher paths:(NSArray<NSString *> *)paths device:(uint64_t)device andTargetQueue:(dispatch_queue_t)target
+{
+	if ( self = [super init] )
+	{
+		_watcher = watcher;
+		_paths = [paths copy];
+		_device = device;
+
+		NSString *label = [NSString stringWithFormat:@"ca.huxtable.CBHFileSystemEventKit.shard.%llx", device];
+		_queue = dispatch_queue_create([label UTF8String], DISPATCH_QUEUE_SERIAL);
+		if ( target ) { dispatch_set_target_queue(_queue, target); }
+		dispatch_queue_set_specific(_queue, &_CBHFileSystemWatcherShard_queueKey, (__bridge void *)watcher, NULL);
+
+		_stream = nil;
+		atomic_init(&_isStopped, NO);
+	}
+
+	return self;
+}
+
+
+#pragma mark - Properties
+
+@synthesize paths = _paths;
+@synthesize device = _device;
+
+
+#pragma mark - Watching
+
+- (BOOL)startWithLatency:(NSTimeInterval)latency andFlags:(FSEventStreamCreateFlags)flags
+{
+	if ( _stream ) { return YES; }
+	atomic_store_explicit(&_isStopped, NO, memory_order_relaxed);
+
+	CFArrayRef cfPaths = (__bridge CFArrayRef)_paths;
+	FSEventStreamContext context = {0, (__bridge void *)self, CFRetain, CFRelease, CFCopyDescription};
+
+	_stream = FSEventStreamCreate(NULL, &fsShardEventCallback, &context, cfPaths, kFSEventStreamEventIdSinceNow, (CFAbsoluteTime)latency, flags);
+	if ( !_stream ) { return NO; }
+
+	FSEventStreamSetDispatchQueue(_stream, _queue);
+	if ( !FSEventStreamStart(_stream) )
+	{
+		[self stop];
+		return NO;
+	}
+
+	return YES;
+}
+
+- (void)stop
+{
+	if ( !_stream ) { return; }
+
+	/// From inside a batch of the same watcher, waiting on any of its shard queues could deadlock, ordered or not.
+	BOOL isInBatch = ( dispatch_get_specific(&_CBHFileSystemWatcherShard_queueKey) == dispatch_queue_get_specific(_queue, &_CBHFileSystemWatcherShard_queueKey) );
+
+	/// Deliver anything still within the latency window, as an unsharded watcher does.
+	if ( !isInBatch ) { FSEventStreamFlushSync(_stream); }
+
+	atomic_store_explicit(&_isStopped, YES, memory_order_release);
+
+	FSEventStreamStop(_stream);
+	FSEventStreamInvalidate(_stream);
+	FSEventStreamRelease(_stream);
+
+	_stream = nil;
+
+	/// Wait out a batch which was already running so nothing is delivered once this returns.
+	if ( !isInBatch ) { dispatch_sync(_queue, ^{}); }
+}
+
+- (void)flush
+{
+	if ( !_stream ) { return; }
+
+	FSEventStreamFlushAsync(_stream);
+}
+
+
+#pragma mark - Description
+
+- (NSString *)description
+{
+	if ( !_stream ) { return [NSString stringWithFormat:@"Device %llx: %@", _device, _paths]; }
+
+	return (__bridge NSString *)CFAutorelease(FSEventStreamCopyDescription(_stream));
+}
+
+
+#pragma mark - Event
+
+- (void)receiveEventsWithCount:(size_t)count paths:(const char * const *)paths flags:(const FSEventStreamEventFlags *)flags andIds:(const FSEventStreamEventId *)ids
+{
+	if ( atomic_load_explicit(&_isStopped, memory_order_acquire) ) { return; }
+
+	CBHFileSystemWatcher *watcher = _watcher;
+	[watcher triggerEventsWithCount:count paths:paths flags:flags andIds:ids];
+}
+
+@end
+
+
+#pragma mark - Callback
+
+static void fsShardEventCallback(ConstFSEventStreamRef streamRef, void *info, size_t numEvents, void *eventPaths, const FSEventStreamEventFlags eventFlags[], const FSEventStreamEventId eventIds[])
+{
+	_CBHFileSystemWatcherShard *shard = (__bridge _CBHFileSystemWatcherShard *)info;
+	[shard receiveEventsWithCount:numEvents paths:(const char * const *)eventPaths flags:eventFlags andIds:eventIds];
+}
@@ -0,0 +1,109 @@
+//  CBHDeviceShardsTests.cpp
+//  CBHFileSystemEventKitTests
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include "CBHDeviceShards.hpp"
+#include "CBHTestAssert.hpp"
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+
+namespace
+{
+	std::string sampleDirectory()
+	{
+		char path[] = "/tmp/CBHDeviceShardsTests.XXXXXX";
+		return ::mkdtemp(path) ? std::string(path) : std::string("/tmp");
+	}
+
+
+	// MARK: - Devices
+
+	void testDevice_existing()
+	{
+		std::string dir = sampleDirectory();
+
+		CBHTestExpect(cbh::deviceOfPath(dir) != 0, "An existing path should have a device.");
+		CBHTestExpect(cbh::deviceOfPath(dir) == cbh::deviceOfPath(dir + "/"), "A trailing slash should not change the device.");
+
+		::rmdir(dir.c_str());
+	}
+
+	void testDevice_missing()
+	{
+		std::string dir = sampleDirectory();
+
+		CBHTestExpect(cbh::deviceOfPath(dir + "/missing/file.sample") == cbh::deviceOfPath(dir), "A missing path should use the device of its nearest ancestor.");
+		CBHTestExpect(cbh::deviceOfPath("relative/missing.sample") == cbh::deviceOfPath("."), "A missing relative path should use the device of the working directory.");
+
+		::rmdir(dir.c_str());
+	}
+
+
+	// MARK: - Sharding
+
+	void testShard_sameDevice()
+	{
+		std::string dir = sampleDirectory();
+
+		std::vector<cbh::DeviceShard> shards = cbh::shardByDevice({dir, dir + "/a.sample", dir + "/b.sample"});
+		::rmdir(dir.c_str());
+
+		CBHTestRequire(shards.size() == 1, "Paths on one device should share a shard.");
+		CBHTestRequire(shards[0].indices.size() == 3, "Every path should be in the shard.");
+		CBHTestExpect(shards[0].indices[0] == 0 && shards[0].indices[2] == 2, "Paths should keep their order.");
+	}
+
+	void testShard_empty()
+	{
+		CBHTestExpect(cbh::shardByDevice({}).empty(), "No paths should produce no shards.");
+	}
+
+#ifdef __linux__
+	void testShard_separateDevices()
+	{
+		std::string dir = sampleDirectory();
+
+		/// procfs is always its own mount on Linux.
+		std::vector<cbh::DeviceShard> shards = cbh::shardByDevice({dir, "/proc/self", dir + "/a.sample"});
+		::rmdir(dir.c_str());
+
+		CBHTestRequire(shards.size() == 2, "Paths on different devices should be in different shards.");
+		CBHTestExpect(shards[0].indices.size() == 2 && shards[0].indices[1] == 2, "Paths on the first device should be grouped.");
+		CBHTestExpect(shards[1].indices.size() == 1 && shards[1].indices[0] == 1, "Paths on the second device should be grouped.");
+	}
+#endif
+}
+
+
+int main()
+{
+	return cbh::test::run({
+		testDevice_existing,
+		testDevice_missing,
+
+		testShard_sameDevice,
+		testShard_empty,
+#ifdef __linux__
+		testShard_separateDevices,
+#endif
+	});
+}
@@ -0,0 +1,193 @@
+//  CBHEventPipelineTests.cpp
+//  CBHFileSystemEventKitTests
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include "CBHEventPipeline.hpp"
+#include "CBHTestAssert.hpp"
+
+#include <string>
+#include <vector>
+
+
+namespace
+{
+	/// Records every event it receives, copying paths since they do not outlive the batch.
+	struct RecordingSink
+	{
+		std::vector<std::string> *paths;
+		std::vector<std::uint64_t> *flags;
+		std::vector<std::uint64_t> *ids;
+
+		void operator()(const cbh::Event &event) const
+		{
+			paths->emplace_back(event.path);
+			flags->push_back(event.flags);
+			ids->push_back(event.eventId);
+		}
+	};
+
+	struct Recording
+	{
+		std::vector<std::string> paths;
+		std::vector<std::uint64_t> flags;
+		std::vector<std::uint64_t> ids;
+
+		RecordingSink sink() { return {&paths, &flags, &ids}; }
+	};
+
+	using Source = cbh::ParallelArraySource<std::uint32_t, std::uint64_t>;
+
+	const char *kPaths[] = {"/a", "/a", "/b", "/a", "/c", "/c"};
+	const std::uint32_t kFlags[] = {0x1, 0x2, 0x4, 0x8, 0x10, 0x20};
+	const std::uint64_t kIds[] = {1, 2, 3, 4, 5, 6};
+	const Source::Batch kBatch = {6, kPaths, kFlags, kIds};
+
+
+	// MARK: - Sources
+
+	void testSource_parallelArrays()
+	{
+		Recording recording;
+		cbh::EventPipeline<Source, cbh::AcceptAll, cbh::NoCoalescing, RecordingSink> pipeline(recording.sink());
+
+		pipeline(kBatch);
+
+		CBHTestRequire(recording.paths.size() == 6, "Every event should reach the sink.");
+		CBHTestExpect(recording.paths[2] == "/b", "Events should arrive in order.");
+		CBHTestExpect(recording.flags[4] == 0x10, "Flags should be carried through.");
+		CBHTestExpect(recording.ids[5] == 6, "Ids should be carried through.");
+	}
+
+	void testSource_eventArray()
+	{
+		const cbh::Event events[] = {{"/x", 0x1, 10}, {"/y", 0x2, 11}};
+
+		Recording recording;
+		cbh::EventPipeline<cbh::EventArraySource, cbh::AcceptAll, cbh::NoCoalescing, RecordingSink> pipeline(recording.sink());
+
+		pipeline({events, 2});
+
+		CBHTestRequire(recording.paths.size() == 2, "Every event should reach the sink.");
+		CBHTestExpect(recording.paths[1] == "/y", "Events should arrive in order.");
+	}
+
+	void testSource_emptyBatch()
+	{
+		Recording recording;
+		cbh::EventPipeline<Source, cbh::AcceptAll, cbh::AdjacentPathCoalescing, RecordingSink> pipeline(recording.sink());
+
+		pipeline({0, kPaths, kFlags, kIds});
+
+		CBHTestExpect(recording.paths.empty(), "An empty batch should produce no events.");
+	}
+
+
+	// MARK: - Filters
+
+	void testFilter_anyFlags()
+	{
+		Recording recording;
+		cbh::EventPipeline<Source, cbh::AnyFlags, cbh::NoCoalescing, RecordingSink> pipeline(recording.sink(), cbh::AnyFlags{0x2 | 0x20});
+
+		pipeline(kBatch);
+
+		CBHTestRequire(recording.ids.size() == 2, "Only matching events should reach the sink.");
+		CBHTestExpect(recording.ids[0] == 2 && recording.ids[1] == 6, "The matching events should reach the sink.");
+	}
+
+	void testFilter_allOf()
+	{
+		using Filter = cbh::AllOf<cbh::NoFlags, cbh::NoFlags>;
+
+		Recording recording;
+		cbh::EventPipeline<Source, Filter, cbh::NoCoalescing, RecordingSink> pipeline(recording.sink(), Filter{{cbh::NoFlags{0x1}, cbh::NoFlags{0x4 | 0x8}}});
+
+		pipeline(kBatch);
+
+		CBHTestRequire(recording.ids.size() == 3, "Events rejected by any filter should not reach the sink.");
+		CBHTestExpect(recording.ids[0] == 2 && recording.ids[1] == 5 && recording.ids[2] == 6, "Events accepted by every filter should reach the sink.");
+	}
+
+	void testFilter_anyOf()
+	{
+		using Filter = cbh::AnyOf<cbh::AnyFlags, cbh::AnyFlags>;
+
+		Recording recording;
+		cbh::EventPipeline<Source, Filter, cbh::NoCoalescing, RecordingSink> pipeline(recording.sink(), Filter{{cbh::AnyFlags{0x1}, cbh::AnyFlags{0x4}}});
+
+		pipeline(kBatch);
+
+		CBHTestRequire(recording.ids.size() == 2, "Events accepted by any filter should reach the sink.");
+		CBHTestExpect(recording.ids[0] == 1 && recording.ids[1] == 3, "Events accepted by any filter should reach the sink.");
+	}
+
+
+	// MARK: - Coalescers
+
+	void testCoalescer_adjacentPath()
+	{
+		Recording recording;
+		cbh::EventPipeline<Source, cbh::AcceptAll, cbh::AdjacentPathCoalescing, RecordingSink> pipeline(recording.sink());
+
+		pipeline(kBatch);
+
+		CBHTestRequire(recording.paths.size() == 4, "Consecutive events for a path should be merged.");
+		CBHTestExpect(recording.paths[0] == "/a" && recording.flags[0] == (0x1 | 0x2) && recording.ids[0] == 2, "Merged events should combine flags and keep the latest id.");
+		CBHTestExpect(recording.paths[2] == "/a" && recording.ids[2] == 4, "Non-consecutive events should not be merged.");
+		CBHTestExpect(recording.paths[3] == "/c" && recording.flags[3] == (0x10 | 0x20), "The final run should be flushed at the end of the batch.");
+	}
+
+	void testCoalescer_afterFilter()
+	{
+		Recording recording;
+		cbh::EventPipeline<Source, cbh::NoFlags, cbh::AdjacentPathCoalescing, RecordingSink> pipeline(recording.sink(), cbh::NoFlags{0x4});
+
+		pipeline(kBatch);
+
+		CBHTestRequire(recording.paths.size() == 2, "Events made adjacent by filtering should be merged.");
+		CBHTestExpect(recording.flags[0] == (0x1 | 0x2 | 0x8) && recording.ids[0] == 4, "Merged events should combine flags and keep the latest id.");
+	}
+
+	void testCoalescer_doesNotSpanBatches()
+	{
+		Recording recording;
+		cbh::EventPipeline<Source, cbh::AcceptAll, cbh::AdjacentPathCoalescing, RecordingSink> pipeline(recording.sink());
+
+		pipeline({1, kPaths, kFlags, kIds});
+		pipeline({1, kPaths + 1, kFlags + 1, kIds + 1});
+
+		CBHTestExpect(recording.paths.size() == 2, "Runs should not span batches.");
+	}
+}
+
+
+int main()
+{
+	return cbh::test::run({
+		testSource_parallelArrays,
+		testSource_eventArray,
+		testSource_emptyBatch,
+
+		testFilter_anyFlags,
+		testFilter_allOf,
+		testFilter_anyOf,
+
+		testCoalescer_adjacentPath,
+		testCoalescer_afterFilter,
+		testCoalescer_doesNotSpanBatches,
+	});
+}
@@ -0,0 +1,138 @@
+//  CBHFileSystemEventBroadcasterTests.m
+//  CBHFileSystemEventKitTests
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+@import XCTest;
+@import CBHFileSystemEventKit;
+
+#import "CBHTestFileSystemCase.h"
+
+#import "XCTestCase+Utilities.h"
+#import "CBHTestAssert.h"
+#import "CBHTestSharedMemory.h"
+#import "CBHTestExpectation.h"
+
+
+CBHFileSystemWatcherType kBroadcastWatcherType = CBHFileSystemWatcherType_default | CBHFileSystemWatcherType_noDefer;
+
+CGFloat kBroadcastTimeout = 0.5;
+CGFloat kBroadcastLatency = 0.01;
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface CBHFileSystemEventBroadcasterTests : CBHTestFileSystemCase
+@end
+
+NS_ASSUME_NONNULL_END
+
+
+@implementation CBHFileSystemEventBroadcasterTests
+
+#pragma mark - Attaching
+
+- (void)testReader_attach
+{
+	/// Setup Directory to work in and Broadcaster
+	NSString *dir = CBHTestDirectory_samplePath();
+	CBHFileSystemEventBroadcaster *broadcaster = [CBHFileSystemEventBroadcaster broadcasterWithName:CBHTestSharedMemory_name() ofPaths:@[dir] withType:kBroadcastWatcherType andLatency:kBroadcastLatency];
+	XCTAssertNotNil(broadcaster, @"Broadcaster should have been created.");
+	XCTAssertEqual([broadcaster readerCount], 0, @"Broadcaster should have no readers.");
+
+	/// Attach Reader
+	CBHFileSystemEventReader *reader = [[CBHFileSystemEventReader alloc] initWithName:[broadcaster name]];
+	XCTAssertNotNil(reader, @"Reader should have attached.");
+	XCTAssertEqualObjects([reader paths], @[dir], @"Reader should see the broadcaster's paths.");
+	XCTAssertEqual([broadcaster readerCount], 1, @"Broadcaster should have one reader.");
+
+	/// Detach Reader and cleanup
+	reader = nil;
+	XCTAssertEqual([broadcaster readerCount], 0, @"Broadcaster should have no readers.");
+	[broadcaster stopWatching];
+}
+
+- (void)testReader_attachMissing
+{
+	CBHFileSystemEventReader *reader = [[CBHFileSystemEventReader alloc] initWithName:CBHTestSharedMemory_name()];
+	XCTAssertNil(reader, @"Reader should not attach to a missing broadcaster.");
+}
+
+- (void)testBroadcaster_nameInUse
+{
+	/// Setup Directory to work in and Broadcaster
+	NSString *dir = CBHTestDirectory_samplePath();
+	CBHFileSystemEventBroadcaster *broadcaster = [CBHFileSystemEventBroadcaster broadcasterWithName:CBHTestSharedMemory_name() ofPaths:@[dir] withType:kBroadcastWatcherType andLatency:kBroadcastLatency];
+	CBHFileSystemEventReader *reader = [[CBHFileSystemEventReader alloc] initWithName:[broadcaster name]];
+
+	/// A second Broadcaster must not take over the name
+	CBHFileSystemEventBroadcaster *other = [CBHFileSystemEventBroadcaster broadcasterWithName:[broadcaster name] ofPaths:@[dir] withType:kBroadcastWatcherType andLatency:kBroadcastLatency];
+	XCTAssertNil(other, @"Broadcaster should not be created with a name in use.");
+	XCTAssertEqual([broadcaster readerCount], 1, @"Broadcaster should keep its reader.");
+
+	/// Cleanup
+	reader = nil;
+	[broadcaster stopWatching];
+}
+
+
+#pragma mark - Reading
+
+- (void)testReaderBlock_basicCreation
+{
+	/// Setup Directory to work in and Broadcaster
+	NSString *dir = CBHTestDirectory_samplePath();
+	CBHFileSystemEventBroadcaster *broadcaster = [CBHFileSystemEventBroadcaster broadcasterWithName:CBHTestSharedMemory_name() ofPaths:@[dir] withType:kBroadcastWatcherType andLatency:kBroadcastLatency];
+
+	/// Setup Expectation and Reader
+	CBHTestExpectation *expectation = [self expectationWithDescription:@"Reading creation in a broadcast directory" context:dir andFulfillmentCount:1];
+	CBHFileSystemEventReader *reader = [CBHFileSystemEventReader readerWithName:[broadcaster name] andBlock:^(CBHFileSystemEvent *event) {
+		XCTAssertEqualObjects([[expectation context] stringByStandardizingPath], [[event path] stringByStandardizingPath], @"Paths should be the same in order to fulfill.");
+		[expectation fulfill];
+	}];
+	XCTAssertTrue([reader isReading], @"Reader should be reading.");
+
+	/// Create new File in Dir
+	CBHTestFile_sampleFile(@"Sample Data");
+
+	/// Wait for callback and cleanup
+	[self waitForExpectation:expectation timeout:kBroadcastTimeout];
+	[reader stopReading];
+	[broadcaster stopWatching];
+}
+
+- (void)testReaderPull_basicCreation
+{
+	/// Setup Directory to work in, Broadcaster, and Reader
+	NSString *dir = CBHTestDirectory_samplePath();
+	CBHFileSystemEventBroadcaster *broadcaster = [CBHFileSystemEventBroadcaster broadcasterWithName:CBHTestSharedMemory_name() ofPaths:@[dir] withType:kBroadcastWatcherType andLatency:kBroadcastLatency];
+	CBHFileSystemEventReader *reader = [[CBHFileSystemEventReader alloc] initWithName:[broadcaster name]];
+	XCTAssertEqual([[reader readEvents] count], 0, @"Reader should start with no events.");
+
+	/// Create new File in Dir and let the broadcaster publish
+	CBHTestFile_sampleFile(@"Sample Data");
+	[[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:kBroadcastTimeout]];
+
+	/// Read and cleanup
+	NSArray<CBHFileSystemEvent *> *events = [reader readEvents];
+	XCTAssertGreaterThan([events count], 0, @"Reader should have received events.");
+	XCTAssertEqualObjects([[[events firstObject] path] stringByStandardizingPath], [dir stringByStandardizingPath], @"Paths should be the same.");
+	XCTAssertEqual([[reader readEvents] count], 0, @"Events should only be read once.");
+
+	[broadcaster stopWatching];
+}
+
+@end
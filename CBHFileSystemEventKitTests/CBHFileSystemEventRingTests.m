@@ -0,0 +1,291 @@
+//  CBHFileSystemEventRingTests.m
+//  CBHFileSystemEventKitTests
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+@import XCTest;
+@import CBHFileSystemEventKit;
+
+#import <CBHFileSystemEventKit/_CBHFileSystemEventRing.h>
+
+#import "CBHTestAssert.h"
+#import "CBHTestSharedMemory.h"
+
+
+/// Every path encodes its event id, and varies in length so records do not line up with the end of the ring.
+#define CBHTestRing_path(eventId) [NSString stringWithFormat:@"/ring/%020llu/%@", (unsigned long long)(eventId), [@"" stringByPaddingToLength:(NSUInteger)((eventId) % 37) withString:@"x" startingAtIndex:0]]
+
+/// The smallest a record can be, so writing `capacity / kRecordMinimumSize` events always laps the ring.
+size_t kRecordMinimumSize = 56;
+
+CBHFileSystemEventType kDroppedType = CBHFileSystemEventType_mustScanSubDirs | CBHFileSystemEventType_userDropped;
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface CBHFileSystemEventRingTests : XCTestCase
+@end
+
+NS_ASSUME_NONNULL_END
+
+
+@implementation CBHFileSystemEventRingTests
+
+#pragma mark - Helpers
+
+- (NSArray<NSString *> *)roots
+{
+	return @[@"/ring/a", @"/ring/b"];
+}
+
+- (void)writeToRing:(_CBHFileSystemEventRing *)ring count:(size_t)count fromId:(UInt64)firstId
+{
+	NSMutableArray<NSString *> *paths = [NSMutableArray arrayWithCapacity:count];
+	NSMutableData *pathData = [NSMutableData dataWithLength:count * sizeof(const char *)];
+	NSMutableData *flagData = [NSMutableData dataWithLength:count * sizeof(FSEventStreamEventFlags)];
+	NSMutableData *idData = [NSMutableData dataWithLength:count * sizeof(FSEventStreamEventId)];
+
+	const char **cPaths = (const char **)[pathData mutableBytes];
+	FSEventStreamEventFlags *flags = (FSEventStreamEventFlags *)[flagData mutableBytes];
+	FSEventStreamEventId *ids = (FSEventStreamEventId *)[idData mutableBytes];
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		NSString *path = CBHTestRing_path(firstId + i);
+		[paths addObject:path];
+
+		cPaths[i] = [path fileSystemRepresentation];
+		flags[i] = kFSEventStreamEventFlagItemCreated;
+		ids[i] = firstId + i;
+	}
+
+	[ring writeEventsWithCount:count paths:cPaths flags:flags andIds:ids];
+}
+
+- (void)assertEvents:(NSArray<CBHFileSystemEvent *> *)events areCount:(size_t)count fromId:(UInt64)firstId
+{
+	XCTAssertEqual([events count], count, @"Every event should be read exactly once.");
+
+	for (NSUInteger i = 0; i < MIN([events count], count); ++i)
+	{
+		CBHFileSystemEvent *event = events[i];
+		XCTAssertEqual([event eventId], firstId + i, @"Events should be read in the order they were written.");
+		XCTAssertEqualObjects([event path], CBHTestRing_path(firstId + i), @"Events should keep their paths.");
+		XCTAssertEqual([event type], CBHFileSystemEventType_itemCreated, @"Events should keep their types.");
+	}
+}
+
+- (void)assertEventsAreDropped:(NSArray<CBHFileSystemEvent *> *)events
+{
+	XCTAssertEqual([events count], [[self roots] count], @"A lapped reader should receive one event per root.");
+
+	for (NSUInteger i = 0; i < MIN([events count], [[self roots] count]); ++i)
+	{
+		XCTAssertEqualObjects([events[i] path], [self roots][i], @"Dropped events should name the roots.");
+		XCTAssertEqual([events[i] type], kDroppedType, @"Dropped events should ask for a rescan.");
+	}
+}
+
+
+#pragma mark - Ownership
+
+- (void)testRing_capacityTooLarge
+{
+	XCTAssertNil([[_CBHFileSystemEventRing alloc] initOwnerWithName:CBHTestSharedMemory_name() roots:[self roots] andCapacity:SIZE_MAX], @"Ring should not be created with an unreachable capacity.");
+	XCTAssertNil([[_CBHFileSystemEventRing alloc] initOwnerWithName:CBHTestSharedMemory_name() roots:[self roots] andCapacity:(1ULL << 31) + 1], @"Ring should not be created with a capacity records cannot describe.");
+}
+
+- (void)testRing_nameInUse
+{
+	NSString *name = CBHTestSharedMemory_name();
+	_CBHFileSystemEventRing *owner = [[_CBHFileSystemEventRing alloc] initOwnerWithName:name roots:[self roots] andCapacity:0];
+	_CBHFileSystemEventRing *reader = [[_CBHFileSystemEventRing alloc] initReaderWithName:name];
+	XCTAssertNotNil(owner, @"Ring should have been created.");
+	XCTAssertNotNil(reader, @"Reader should have attached.");
+
+	/// A second owner must not take the name from a live one.
+	_CBHFileSystemEventRing *usurper = [[_CBHFileSystemEventRing alloc] initOwnerWithName:name roots:[self roots] andCapacity:0];
+	XCTAssertNil(usurper, @"Ring should not be created over a live owner.");
+
+	/// The first owner should still reach its readers.
+	[self writeToRing:owner count:3 fromId:1];
+	[self assertEvents:[reader readEventsWithObject:nil] areCount:3 fromId:1];
+
+	/// Once released the name is free again.
+	reader = nil;
+	owner = nil;
+	_CBHFileSystemEventRing *successor = [[_CBHFileSystemEventRing alloc] initOwnerWithName:name roots:[self roots] andCapacity:0];
+	XCTAssertNotNil(successor, @"Ring should be created once the previous owner is gone.");
+}
+
+- (void)testRing_ownerReleased
+{
+	NSString *name = CBHTestSharedMemory_name();
+	_CBHFileSystemEventRing *owner = [[_CBHFileSystemEventRing alloc] initOwnerWithName:name roots:[self roots] andCapacity:0];
+	_CBHFileSystemEventRing *reader = [[_CBHFileSystemEventRing alloc] initReaderWithName:name];
+
+	/// Everything published before the owner goes should still be read, followed by dropped events.
+	[self writeToRing:owner count:3 fromId:1];
+	owner = nil;
+
+	NSArray<CBHFileSystemEvent *> *events = [reader readEventsWithObject:nil];
+	XCTAssertEqual([events count], 3 + [[self roots] count], @"Reader should read what was published and then drop.");
+	if ( [events count] == 3 + [[self roots] count] )
+	{
+		[self assertEvents:[events subarrayWithRange:NSMakeRange(0, 3)] areCount:3 fromId:1];
+		[self assertEventsAreDropped:[events subarrayWithRange:NSMakeRange(3, [[self roots] count])]];
+	}
+	XCTAssertFalse([reader isAttached], @"Reader should have detached.");
+	XCTAssertEqual([[reader readEventsWithObject:nil] count], 0, @"A detached reader should read nothing.");
+
+	/// A new owner under the same name should be picked up from its first event.
+	owner = [[_CBHFileSystemEventRing alloc] initOwnerWithName:name roots:[self roots] andCapacity:0];
+	[self writeToRing:owner count:2 fromId:10];
+	[self assertEvents:[reader readEventsWithObject:nil] areCount:2 fromId:10];
+	XCTAssertTrue([reader isAttached], @"Reader should have attached to the new owner.");
+}
+
+- (void)testRing_ownerReplaced
+{
+	NSString *name = CBHTestSharedMemory_name();
+	_CBHFileSystemEventRing *owner = [[_CBHFileSystemEventRing alloc] initOwnerWithName:name roots:[self roots] andCapacity:0];
+	_CBHFileSystemEventRing *reader = [[_CBHFileSystemEventRing alloc] initReaderWithName:name];
+
+	/// Replace the owner before the reader notices.
+	owner = nil;
+	owner = [[_CBHFileSystemEventRing alloc] initOwnerWithName:name roots:[self roots] andCapacity:0];
+	XCTAssertNotNil(owner, @"Ring should be created once the previous owner is gone.");
+	[self writeToRing:owner count:4 fromId:20];
+
+	/// The reader should report the gap, then follow the name to the new ring.
+	NSArray<CBHFileSystemEvent *> *events = [reader readEventsWithObject:nil];
+	XCTAssertEqual([events count], [[self roots] count] + 4, @"Reader should drop and then read the new ring.");
+	if ( [events count] == [[self roots] count] + 4 )
+	{
+		[self assertEventsAreDropped:[events subarrayWithRange:NSMakeRange(0, [[self roots] count])]];
+		[self assertEvents:[events subarrayWithRange:NSMakeRange([[self roots] count], 4)] areCount:4 fromId:20];
+	}
+	XCTAssertTrue([reader isAttached], @"Reader should be attached to the new owner.");
+	XCTAssertEqual([owner readerCount], 1, @"New owner should see the reader.");
+}
+
+
+#pragma mark - Reading
+
+- (void)testRing_readWrite
+{
+	NSString *name = CBHTestSharedMemory_name();
+	_CBHFileSystemEventRing *owner = [[_CBHFileSystemEventRing alloc] initOwnerWithName:name roots:[self roots] andCapacity:0];
+	_CBHFileSystemEventRing *reader = [[_CBHFileSystemEventRing alloc] initReaderWithName:name];
+	XCTAssertEqualObjects([reader roots], [self roots], @"Reader should see the owner's roots.");
+	XCTAssertEqual([[reader readEventsWithObject:nil] count], 0, @"Reader should start with no events.");
+
+	[self writeToRing:owner count:10 fromId:1];
+	[self assertEvents:[reader readEventsWithObject:nil] areCount:10 fromId:1];
+	XCTAssertEqual([[reader readEventsWithObject:nil] count], 0, @"Events should only be read once.");
+}
+
+- (void)testRing_wraparound
+{
+	NSString *name = CBHTestSharedMemory_name();
+	_CBHFileSystemEventRing *owner = [[_CBHFileSystemEventRing alloc] initOwnerWithName:name roots:[self roots] andCapacity:0];
+	_CBHFileSystemEventRing *reader = [[_CBHFileSystemEventRing alloc] initReaderWithName:name];
+
+	/// Go round the ring several times, reading often enough never to be lapped, through every kind of padding.
+	size_t batch = 61;
+	size_t total = 8 * [owner capacity] / kRecordMinimumSize;
+	for (UInt64 eventId = 1; eventId < total; eventId += batch)
+	{
+		[self writeToRing:owner count:batch fromId:eventId];
+		[self assertEvents:[reader readEventsWithObject:nil] areCount:batch fromId:eventId];
+	}
+}
+
+- (void)testRing_lappedReader
+{
+	NSString *name = CBHTestSharedMemory_name();
+	_CBHFileSystemEventRing *owner = [[_CBHFileSystemEventRing alloc] initOwnerWithName:name roots:[self roots] andCapacity:0];
+	_CBHFileSystemEventRing *reader = [[_CBHFileSystemEventRing alloc] initReaderWithName:name];
+
+	/// Write more than the ring holds, a batch at a time, without reading.
+	size_t batch = 100;
+	size_t total = [owner capacity] / kRecordMinimumSize + batch;
+	for (UInt64 eventId = 1; eventId < total; eventId += batch) { [self writeToRing:owner count:batch fromId:eventId]; }
+
+	[self assertEventsAreDropped:[reader readEventsWithObject:nil]];
+	XCTAssertEqual([[reader readEventsWithObject:nil] count], 0, @"Dropped events should only be read once.");
+
+	/// Reading should carry on from the owner's position.
+	[self writeToRing:owner count:3 fromId:total + 1];
+	[self assertEvents:[reader readEventsWithObject:nil] areCount:3 fromId:total + 1];
+}
+
+- (void)testRing_oversizedBatch
+{
+	NSString *name = CBHTestSharedMemory_name();
+	_CBHFileSystemEventRing *owner = [[_CBHFileSystemEventRing alloc] initOwnerWithName:name roots:[self roots] andCapacity:0];
+	_CBHFileSystemEventRing *reader = [[_CBHFileSystemEventRing alloc] initReaderWithName:name];
+
+	/// A single batch larger than the ring.
+	size_t count = 2 * [owner capacity] / kRecordMinimumSize;
+	[self writeToRing:owner count:count fromId:1];
+
+	[self assertEventsAreDropped:[reader readEventsWithObject:nil]];
+
+	/// Reading should carry on from the owner's position.
+	[self writeToRing:owner count:5 fromId:count + 1];
+	[self assertEvents:[reader readEventsWithObject:nil] areCount:5 fromId:count + 1];
+}
+
+- (void)testRing_concurrentWriter
+{
+	NSString *name = CBHTestSharedMemory_name();
+	_CBHFileSystemEventRing *owner = [[_CBHFileSystemEventRing alloc] initOwnerWithName:name roots:[self roots] andCapacity:0];
+	_CBHFileSystemEventRing *reader = [[_CBHFileSystemEventRing alloc] initReaderWithName:name];
+
+	/// Write many times the ring's capacity while reading, so the reader is both lapped and overwritten mid-copy.
+	size_t batch = 200;
+	size_t total = 64 * [owner capacity] / kRecordMinimumSize;
+	dispatch_group_t group = dispatch_group_create();
+	dispatch_group_async(group, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+		for (UInt64 eventId = 1; eventId < total; eventId += batch)
+		{
+			@autoreleasepool { [self writeToRing:owner count:batch fromId:eventId]; }
+		}
+	});
+
+	/// Every event read must be exactly as written, or replaced by dropped events.
+	UInt64 lastId = 0;
+	BOOL isWriting = YES;
+	while ( isWriting )
+	{
+		isWriting = ( dispatch_group_wait(group, DISPATCH_TIME_NOW) != 0 );
+
+		@autoreleasepool
+		{
+			for (CBHFileSystemEvent *event in [reader readEventsWithObject:nil])
+			{
+				if ( [event type] == kDroppedType ) { continue; }
+
+				XCTAssertGreaterThan([event eventId], lastId, @"Events should be read in the order they were written.");
+				XCTAssertEqualObjects([event path], CBHTestRing_path([event eventId]), @"Events should never be torn.");
+				lastId = [event eventId];
+			}
+		}
+	}
+}
+
+@end
@@ -19,6 +19,9 @@
 @import XCTest;
 @import CBHFileSystemEventKit;
 
+#import <CBHFileSystemEventKit/_CBHFileSystemWatcher.h>
+#import <CBHFileSystemEventKit/_CBHFileSystemWatcherShard.h>
+
 #import "CBHTestFileSystemCase.h"
 
 #import "XCTestCase+Utilities.h"
@@ -126,6 +129,77 @@ NS_ASSUME_NONNULL_END
 	[watcher stopWatching];
 }
 
+- (void)testDirectoryBlock_keptEvents
+{
+	/// Setup Directory to work in and files to create.
+	NSString *dir = CBHTestDirectory_samplePath();
+	NSString *file1 = [CBHTestFile_samplePath() stringByStandardizingPath];
+	NSString *file2 = [CBHTestFile_samplePath() stringByStandardizingPath];
+
+	/// Setup Expectations and Watcher which keeps the first event for each file along with what it looked like on arrival
+	NSMutableDictionary<NSString *, CBHFileSystemEvent *> *events = [NSMutableDictionary dictionary];
+	NSMutableDictionary<NSString *, NSArray *> *arrivals = [NSMutableDictionary dictionary];
+	CBHTestExpectation *expectation1 = [self expectationWithDescription:@"Keeping the first file's event" context:file1 andFulfillmentCount:1];
+	CBHTestExpectation *expectation2 = [self expectationWithDescription:@"Keeping the second file's event" context:file2 andFulfillmentCount:1];
+	CBHFileSystemWatcher *watcher = [CBHFileSystemWatcher watcherOfPath:dir withType:kDefaultFileWatcherType latency:kDefaultLatency andBlock:^(CBHFileSystemEvent *event) {
+		NSString *path = [[event path] stringByStandardizingPath];
+		if ( ![path isEqualToString:file1] && ![path isEqualToString:file2] ) { return; }
+		if ( events[path] ) { return; }
+
+		events[path] = event;
+		arrivals[path] = @[[event path], @([event type]), @([event eventId])];
+		CBHTestExpectation *expectation = ( [path isEqualToString:file1] ) ? expectation1 : expectation2;
+		[expectation fulfill];
+	}];
+
+	/// Create the first File, then the second in a later batch
+	CBHTestFile_writeAtPath(file1, @"Sample Data");
+	[self waitForExpectation:expectation1 timeout:kDefaultTimeout];
+	CBHTestFile_writeAtPath(file2, @"Sample Data");
+	[self waitForExpectation:expectation2 timeout:kDefaultTimeout];
+
+	/// Cleanup
+	[watcher stopWatching];
+
+	/// Kept events should be distinct and unchanged by the batches which followed them.
+	XCTAssertNotEqual(events[file1], events[file2], @"Kept events should not be reused.");
+	for (NSString *path in @[file1, file2])
+	{
+		CBHFileSystemEvent *event = events[path];
+		XCTAssertEqualObjects([event path], arrivals[path][0], @"Kept events should keep their paths.");
+		XCTAssertEqualObjects(@([event type]), arrivals[path][1], @"Kept events should keep their types.");
+		XCTAssertEqualObjects(@([event eventId]), arrivals[path][2], @"Kept events should keep their ids.");
+	}
+}
+
+- (void)testDirectoryBlock_releasedEvents
+{
+	/// Setup Directory to work in.
+	NSString *dir = CBHTestDirectory_samplePath();
+
+	/// Setup Expectation and Watcher which only holds its events weakly
+	NSHashTable<CBHFileSystemEvent *> *events = [NSHashTable weakObjectsHashTable];
+	__block NSUInteger count = 0;
+	CBHTestExpectation *expectation = [self expectationWithDescription:@"Releasing events with their batch" context:dir andFulfillmentCount:1];
+	CBHFileSystemWatcher *watcher = [CBHFileSystemWatcher watcherOfPath:dir withType:kDefaultDirWatcherType latency:kDefaultLatency andBlock:^(CBHFileSystemEvent *event) {
+		[events addObject:event];
+		++count;
+		[expectation fulfill];
+	}];
+
+	/// Create new File in Dir
+	CBHTestFile_sampleFile(@"Sample Data");
+
+	/// Wait for callback and cleanup
+	[self waitForExpectation:expectation timeout:kDefaultTimeout];
+	[watcher stopWatching];
+
+	/// Events nobody kept should be gone with their batch rather than live on to be handed out again.
+	XCTAssertGreaterThan(count, 0, @"Events should have been delivered.");
+	XCTAssertEqual([[events allObjects] count], 0, @"Events which were not kept should have been released.");
+}
+
+
 #pragma mark - File Observer Tests
 
 - (void)testFileObserver_basicCreation
@@ -200,6 +274,84 @@ NS_ASSUME_NONNULL_END
 }
 
 
+#pragma mark - Sharded Tests
+
+- (void)testShardedBlock_basicCreation
+{
+	/// Setup Directory to work in.
+	NSString *dir = CBHTestDirectory_samplePath();
+
+	/// Setup Expectation and Watcher
+	CBHTestExpectation *expectation = [self expectationWithDescription:@"Watching for creation in a sharded directory" context:dir andFulfillmentCount:1];
+	CBHFileSystemWatcher *watcher = CBHBlockWatcher(dir, kDefaultDirWatcherType | CBHFileSystemWatcherType_shardByDevice, expectation);
+	XCTAssertTrue([watcher isWatching], @"Watcher should be watching.");
+	XCTAssertEqual([[watcher shards] count], 1, @"Watcher should have one shard.");
+
+	/// Create new File in Dir
+	CBHTestFile_sampleFile(@"Sample Data");
+
+	/// Wait for callback and cleanup
+	[self waitForExpectation:expectation timeout:kDefaultTimeout];
+	[watcher stopWatching];
+	XCTAssertFalse([watcher isWatching], @"Watcher should not still be watching.");
+}
+
+- (void)testShardedBlock_separateDevices
+{
+	/// Setup Directories on different devices.
+	NSString *dir = CBHTestDirectory_samplePath();
+	NSArray<NSString *> *paths = @[dir, @"/dev"];
+
+	/// Setup Expectation and Watcher
+	CBHTestExpectation *expectation = [self expectationWithDescription:@"Watching for creation across devices" context:dir andFulfillmentCount:1];
+	CBHFileSystemWatcher *watcher = [CBHFileSystemWatcher watcherOfPaths:paths withType:kDefaultDirWatcherType | CBHFileSystemWatcherType_shardByDevice | CBHFileSystemWatcherType_orderedShards latency:kDefaultLatency andBlock:^(CBHFileSystemEvent *event) {
+		if ( ![[[event path] stringByStandardizingPath] isEqualToString:[dir stringByStandardizingPath]] ) { return; }
+		[expectation fulfill];
+	}];
+
+	/// Each device should have a shard of its own.
+	NSArray<_CBHFileSystemWatcherShard *> *shards = [watcher shards];
+	XCTAssertEqual([shards count], 2, @"Watcher should have a shard per device.");
+	XCTAssertNotEqual([[shards firstObject] device], [[shards lastObject] device], @"Shards should be on different devices.");
+	XCTAssertEqual([[[shards firstObject] paths] count], 1, @"Shards should only have their own device's paths.");
+	XCTAssertEqual([[[shards lastObject] paths] count], 1, @"Shards should only have their own device's paths.");
+
+	/// Create new File in Dir
+	CBHTestFile_sampleFile(@"Sample Data");
+
+	/// Wait for callback and cleanup
+	[self waitForExpectation:expectation timeout:kDefaultTimeout];
+	[watcher stopWatching];
+	XCTAssertNil([watcher shards], @"Watcher should have no shards once stopped.");
+}
+
+- (void)testShardedBlock_stopDelivers
+{
+	/// Setup Directory to work in.
+	NSString *dir = CBHTestDirectory_samplePath();
+
+	/// Setup Watcher with a latency far longer than the test
+	__block NSUInteger deliveredCount = 0;
+	CBHFileSystemWatcher *watcher = [CBHFileSystemWatcher watcherOfPath:dir withType:CBHFileSystemWatcherType_default | CBHFileSystemWatcherType_shardByDevice latency:60.0 andBlock:^(CBHFileSystemEvent *event) {
+		++deliveredCount;
+	}];
+
+	/// Create new File in Dir and give it time to reach the stream
+	CBHTestFile_sampleFile(@"Sample Data");
+	[[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:kDefaultLatency * 20]];
+	XCTAssertEqual(deliveredCount, 0, @"Events should still be waiting out the latency.");
+
+	/// Stopping should deliver the pending events before returning, and nothing after.
+	[watcher stopWatching];
+	NSUInteger stoppedCount = deliveredCount;
+	XCTAssertGreaterThan(stoppedCount, 0, @"Pending events should be delivered by stopping.");
+
+	CBHTestFile_sampleFile(@"Sample Data");
+	[[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:kDefaultLatency * 20]];
+	XCTAssertEqual(deliveredCount, stoppedCount, @"Events should not be delivered once stopped.");
+}
+
+
 #pragma mark - Equality
 
 - (void)testEquality_isEqual
@@ -0,0 +1,56 @@
+//  CBHTestAssert.hpp
+//  CBHFileSystemEventKitTests
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#pragma once
+
+#include <cstdio>
+#include <initializer_list>
+
+
+/// Reports `message` if `condition` does not hold, and carries on.
+#define CBHTestExpect(condition, message) cbh::test::expect((condition), __FILE__, __LINE__, (message))
+
+/// Reports `message` and returns from the test if `condition` does not hold, for checks later assertions rely on.
+#define CBHTestRequire(condition, message) do { if ( !CBHTestExpect(condition, message) ) { return; } } while ( 0 )
+
+
+/// A minimal harness for the C++ core's tests, which build without XCTest.
+namespace cbh::test
+{
+	/// The number of failed assertions so far.
+	inline int failures = 0;
+
+	inline bool expect(bool condition, const char *file, int line, const char *message)
+	{
+		if ( !condition )
+		{
+			std::fprintf(stderr, "%s:%d: %s\n", file, line, message);
+			++failures;
+		}
+
+		return condition;
+	}
+
+	/// Runs each test in turn and returns the exit status for `main`.
+	inline int run(std::initializer_list<void (*)()> tests)
+	{
+		for (void (*test)() : tests) { test(); }
+
+		return ( failures == 0 ) ? 0 : 1;
+	}
+}